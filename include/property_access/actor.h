@@ -0,0 +1,161 @@
+#ifndef EDB_PROPERTY_ACCESS_ACTOR_H
+#define EDB_PROPERTY_ACCESS_ACTOR_H
+
+
+/*
+	This header implements actor-style properties, whose state is owned by one thread.
+
+		obj.count = 5;     // applied directly on the owning thread, otherwise queued.
+		obj.count += 2;    // the whole operation is queued, so concurrent increments are not lost.
+		obj.queue.drain(); // the owning thread applies queued operations, in order per sender.
+
+	Operations from other threads are posted to an actor_queue in the actual struct, a bounded
+		lock-free multi-producer single-consumer ring allocated once at construction.  Each queued
+		operation is a function pointer and a small trivially copyable payload holding its operand,
+		so posting does not allocate.  If the queue is full, senders spin until the owner drains it.
+
+	Reading an actor property is only meaningful on the owning thread.  Postfix increments and
+		decrements are not supported, as the value they return could be stale; use the prefix forms.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Actor(TYPE, NAME, VARIABLE, QUEUE)  -- Read-write value property owned by a single thread.
+
+		TYPE     -- the type of the property, which must be trivially copyable.
+		NAME     -- the name of this property accessor.
+		VARIABLE -- the variable in ACTUAL_STRUCT holding the value.
+		QUEUE    -- a property_access::actor_queue in ACTUAL_STRUCT, to which other threads post.
+
+		e.g:
+
+			struct Counter
+			{
+				struct State {long count = 0; property_access::actor_queue<> queue;};
+
+				PropertyAccessors(State,
+					Actor(long, total, count, queue)
+				);
+
+				Counter() : _property_actual() {}
+				~Counter() {_property_actual.~State();}
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Actor(TYPE, NAME, VARIABLE, QUEUE) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		static constexpr bool _property_option_deferred_modify = true; \
+		TYPE get() const {return (VARIABLE);} \
+		void set(const TYPE &value) {if ((QUEUE).is_owner()) (VARIABLE) = value; else (QUEUE).post([value, target = &(VARIABLE)] {*target = value;});} \
+		template<typename F> void modify(F f) {if ((QUEUE).is_owner()) f(VARIABLE); else (QUEUE).post([f, target = &(VARIABLE)] {f(*target);});}  };
+	#define EDB_PropertyAccessors_Union_Actor(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Actor(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	/*
+		A bounded multi-producer single-consumer queue of operations, owned by one thread.
+			The owner is the constructing thread until set_owner() is called.
+
+		Capacity is rounded up to a power of two.  PayloadSize bounds the size of posted closures.
+	*/
+	template<std::size_t PayloadSize = 2 * sizeof(void*)>
+	class actor_queue
+	{
+	public:
+		explicit actor_queue(std::size_t capacity = 1024)
+		{
+			std::size_t n = 1;
+			while (n < capacity) n <<= 1;
+			_cells.reset(new cell[n]);
+			_mask = n - 1;
+			for (std::size_t i = 0; i < n; ++i) _cells[i].seq.store(i, std::memory_order_relaxed);
+		}
+
+		actor_queue(const actor_queue&)            = delete;
+		actor_queue &operator=(const actor_queue&) = delete;
+
+		void set_owner(std::thread::id id = std::this_thread::get_id()) noexcept    {_owner.store(id, std::memory_order_release);}
+		bool is_owner() const noexcept                                              {return _owner.load(std::memory_order_acquire) == std::this_thread::get_id();}
+
+		std::size_t capacity() const noexcept    {return _mask + 1;}
+
+		// Queue a closure to be invoked by the owner.  Spins while the queue is full.
+		template<typename F>
+		void post(const F &f)
+		{
+			static_assert(std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>,
+				"Operations posted to an actor_queue must be trivially copyable.");
+			static_assert(sizeof(F) <= PayloadSize && alignof(F) <= alignof(std::max_align_t),
+				"Operation is too large for this actor_queue's PayloadSize.");
+
+			cell *c;
+			std::size_t pos = _tail.load(std::memory_order_relaxed);
+			for (unsigned spins = 0;; ++spins)
+			{
+				c = &_cells[pos & _mask];
+				std::size_t seq = c->seq.load(std::memory_order_acquire);
+				auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+				if (diff == 0)
+				{
+					if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+				}
+				else
+				{
+					if (diff < 0 && spins >= 64) std::this_thread::yield();  // Full; wait for the owner.
+					pos = _tail.load(std::memory_order_relaxed);
+				}
+			}
+
+			std::memcpy(c->payload, &f, sizeof(F));
+			c->apply = [](unsigned char *payload) {(*std::launder(reinterpret_cast<F*>(payload)))();};
+			c->seq.store(pos + 1, std::memory_order_release);
+		}
+
+		// Invoke queued operations, up to max of them.  Only the owner may call this.
+		std::size_t drain(std::size_t max = std::size_t(-1))
+		{
+			std::size_t n = 0;
+			for (; n < max; ++n)
+			{
+				cell &c = _cells[_head & _mask];
+				if (c.seq.load(std::memory_order_acquire) != _head + 1) break;
+				c.apply(c.payload);
+				c.seq.store(_head + _mask + 1, std::memory_order_release);
+				++_head;
+			}
+			return n;
+		}
+
+	private:
+		struct cell
+		{
+			std::atomic<std::size_t> seq;
+			void                   (*apply)(unsigned char*);
+			alignas(std::max_align_t) unsigned char payload[PayloadSize];
+		};
+
+		std::unique_ptr<cell[]>      _cells;
+		std::size_t                  _mask;
+		alignas(64) std::atomic<std::size_t> _tail = 0;
+		alignas(64) std::size_t      _head = 0;
+		std::atomic<std::thread::id> _owner = std::this_thread::get_id();
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_ACTOR_H
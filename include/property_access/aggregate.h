@@ -0,0 +1,285 @@
+#ifndef EDB_PROPERTY_ACCESS_AGGREGATE_H
+#define EDB_PROPERTY_ACCESS_AGGREGATE_H
+
+
+/*
+	This header implements grouped aggregation over arrays of property blocks.
+
+		using namespace property_access;
+		auto rows = group_by(units, unit_count, &Unit::team).aggregate(agg_sum(&Unit::score), agg_count(), agg_max(&Unit::hp));
+		for (auto &[team, score, units, hp] : rows) ...
+
+	Rows are std::tuples of a key followed by one result per aggregate, in ascending order of key.
+
+	Floating point keys which are NaN form a single group, ordered after all other keys.
+
+	agg_min and agg_max ignore NaN values, so their results don't depend on the order of blocks;
+		a group whose values are all NaN gives NaN.  agg_sum gives NaN for a group containing one.
+
+	Keys are read through their getter once per block.  Blocks are then assigned group numbers
+		with a hash table when a sample of keys suggests few groups, or by sorting (key, index) pairs
+		when there are many; keys that can't be hashed are always sorted.
+	Each aggregate then reads its own property through the getter in batches, accumulating
+		each batch into per-group results.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		static constexpr std::size_t aggregate_batch = 1024;
+
+		template<typename Property_t>
+		using aggregate_value_t = std::decay_t<typename Property_t::_property_get_t>;
+
+		template<typename Key_t>
+		static constexpr bool is_hashable = std::is_default_constructible_v<std::hash<Key_t>>;
+
+		template<typename T>
+		bool aggregate_is_nan(const T &v)
+		{
+			if constexpr (std::is_floating_point_v<T>) return std::isnan(v);
+			else return false;
+		}
+
+		// Orders keys with <, except that NaNs are equivalent to each other and greater than other keys.
+		struct aggregate_key_less
+		{
+			template<typename T>
+			bool operator()(const T &a, const T &b) const    {return !aggregate_is_nan(a) && (aggregate_is_nan(b) || a < b);}
+		};
+
+		// Compares keys with ==, except that NaNs are equal to each other.
+		struct aggregate_key_equal
+		{
+			template<typename T>
+			bool operator()(const T &a, const T &b) const    {return a == b || (aggregate_is_nan(a) && aggregate_is_nan(b));}
+		};
+
+		// Hashes keys consistently with aggregate_key_equal.
+		template<typename Key_t>
+		struct aggregate_key_hash
+		{
+			std::size_t operator()(const Key_t &k) const
+			{
+				if constexpr (std::is_floating_point_v<Key_t>)
+				{
+					if (std::isnan(k)) return std::size_t(-1);
+					if (k == 0) return std::hash<Key_t>()(Key_t(0));  // Both zeroes.
+				}
+				return std::hash<Key_t>()(k);
+			}
+		};
+
+		template<typename Key_t>
+		using aggregate_key_set = std::unordered_set<Key_t, aggregate_key_hash<Key_t>, aggregate_key_equal>;
+
+		template<typename Key_t, typename T>
+		using aggregate_key_map = std::unordered_map<Key_t, T, aggregate_key_hash<Key_t>, aggregate_key_equal>;
+
+		// Read a property of blocks [first, first + n) into a batch.
+		template<typename Block_t, typename Property_t>
+		void read_column(const Block_t *blocks, std::size_t first, std::size_t n, Property_t Block_t::*member, std::vector<aggregate_value_t<Property_t>> &batch)
+		{
+			batch.clear();
+			for (std::size_t i = first; i < first + n; ++i) batch.push_back((blocks[i].*member)._property_get());
+		}
+
+		// Accumulate a property into per-group results, with combine(result, value).
+		template<typename Result_t, typename Block_t, typename Property_t, typename Combine>
+		std::vector<Result_t> aggregate_column(const Block_t *blocks, const std::vector<std::size_t> &group, std::size_t groups, Property_t Block_t::*member, Combine combine)
+		{
+			std::vector<Result_t> results(groups);
+			std::vector<char> seen(groups, 0);
+			std::vector<aggregate_value_t<Property_t>> batch;
+			batch.reserve(aggregate_batch);
+			for (std::size_t first = 0; first < group.size(); first += aggregate_batch)
+			{
+				std::size_t n = std::min(aggregate_batch, group.size() - first);
+				read_column(blocks, first, n, member, batch);
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					std::size_t g = group[first + i];
+					if (seen[g]) combine(results[g], batch[i]);
+					else {results[g] = batch[i]; seen[g] = 1;}
+				}
+			}
+			return results;
+		}
+	}
+
+
+	// Aggregate: number of blocks in each group.
+	struct count_aggregate
+	{
+		template<typename Block_t>
+		std::vector<std::size_t> operator()(const Block_t*, const std::vector<std::size_t> &group, std::size_t groups) const
+		{
+			std::vector<std::size_t> counts(groups, 0);
+			for (std::size_t g : group) ++counts[g];
+			return counts;
+		}
+	};
+
+	// Aggregate: sum of a property's values in each group.
+	template<typename Block_t, typename Property_t>
+	struct sum_aggregate
+	{
+		Property_t Block_t::*member;
+
+		using value_t = detail::aggregate_value_t<Property_t>;
+		using result_t = std::decay_t<decltype(std::declval<value_t>() + std::declval<value_t>())>;
+
+		std::vector<result_t> operator()(const Block_t *blocks, const std::vector<std::size_t> &group, std::size_t groups) const
+		{
+			return detail::aggregate_column<result_t>(blocks, group, groups, member, [](result_t &r, const value_t &v) {r += v;});
+		}
+	};
+
+	// Aggregate: least or greatest of a property's values in each group, ignoring NaNs.
+	template<typename Block_t, typename Property_t, typename Compare>
+	struct extreme_aggregate
+	{
+		Property_t Block_t::*member;
+
+		using value_t = detail::aggregate_value_t<Property_t>;
+
+		std::vector<value_t> operator()(const Block_t *blocks, const std::vector<std::size_t> &group, std::size_t groups) const
+		{
+			return detail::aggregate_column<value_t>(blocks, group, groups, member, [](value_t &r, const value_t &v)
+				{if (!detail::aggregate_is_nan(v) && (detail::aggregate_is_nan(r) || Compare()(v, r))) r = v;});
+		}
+	};
+
+	inline count_aggregate agg_count()    {return {};}
+
+	template<typename Block_t, typename Property_t>
+	sum_aggregate<Block_t, Property_t> agg_sum(Property_t Block_t::*member)    {return {member};}
+
+	template<typename Block_t, typename Property_t>
+	extreme_aggregate<Block_t, Property_t, std::less<>> agg_min(Property_t Block_t::*member)    {return {member};}
+
+	template<typename Block_t, typename Property_t>
+	extreme_aggregate<Block_t, Property_t, std::greater<>> agg_max(Property_t Block_t::*member)    {return {member};}
+
+
+	/*
+		An array of blocks divided into groups by a key property.  Groups are numbered in ascending order of key.
+	*/
+	template<typename Block_t, typename Key_t>
+	class grouping
+	{
+	public:
+		template<typename Property_t>
+		grouping(const Block_t *blocks, std::size_t count, Property_t Block_t::*key)
+			: _blocks(blocks), _group(count)
+		{
+			std::vector<Key_t> keys;
+			keys.reserve(count);
+			for (std::size_t i = 0; i < count; ++i) keys.push_back((blocks[i].*key)._property_get());
+
+			if (_few_groups(keys)) _group_by_hash(keys);
+			else                   _group_by_sort(keys);
+		}
+
+		std::size_t               size() const    {return _keys.size();}
+		const std::vector<Key_t> &keys() const    {return _keys;}
+
+		// Block i belongs to group group_of(i).
+		std::size_t group_of(std::size_t i) const    {return _group[i];}
+
+		// Compute aggregates for each group, giving rows of (key, results...).
+		template<typename... Aggregate_t>
+		auto aggregate(const Aggregate_t &...aggregates) const
+		{
+			auto columns = std::make_tuple(aggregates(_blocks, _group, _keys.size())...);
+			using row_t = std::tuple<Key_t, typename decltype(aggregates(_blocks, _group, _keys.size()))::value_type...>;
+
+			std::vector<row_t> rows;
+			rows.reserve(_keys.size());
+			for (std::size_t g = 0; g < _keys.size(); ++g)
+				rows.push_back(std::apply([&](auto &...column) {return row_t(_keys[g], std::move(column[g])...);}, columns));
+			return rows;
+		}
+
+	private:
+		// Estimate whether there are few enough distinct keys for hash grouping, from a sample.
+		static bool _few_groups(const std::vector<Key_t> &keys)
+		{
+			if constexpr (!detail::is_hashable<Key_t>) return false;
+			else
+			{
+				constexpr std::size_t samples = 1024;
+				std::size_t step = std::max<std::size_t>(1, keys.size() / samples);
+				detail::aggregate_key_set<Key_t> distinct;
+				std::size_t sampled = 0;
+				for (std::size_t i = 0; i < keys.size(); i += step, ++sampled) distinct.insert(keys[i]);
+				return distinct.size() * 4 <= sampled;
+			}
+		}
+
+		void _group_by_hash(const std::vector<Key_t> &keys)
+		{
+			if constexpr (detail::is_hashable<Key_t>)
+			{
+				detail::aggregate_key_map<Key_t, std::size_t> ids;
+				for (std::size_t i = 0; i < keys.size(); ++i)
+				{
+					auto found = ids.emplace(keys[i], _keys.size());
+					if (found.second) _keys.push_back(keys[i]);
+					_group[i] = found.first->second;
+				}
+
+				// Renumber groups in order of key.
+				std::vector<std::size_t> order(_keys.size()), rank(_keys.size());
+				for (std::size_t g = 0; g < order.size(); ++g) order[g] = g;
+				std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {return detail::aggregate_key_less()(_keys[a], _keys[b]);});
+				std::vector<Key_t> sorted;
+				sorted.reserve(_keys.size());
+				for (std::size_t r = 0; r < order.size(); ++r) {rank[order[r]] = r; sorted.push_back(std::move(_keys[order[r]]));}
+				_keys.swap(sorted);
+				for (std::size_t &g : _group) g = rank[g];
+			}
+		}
+
+		void _group_by_sort(const std::vector<Key_t> &keys)
+		{
+			std::vector<std::size_t> order(keys.size());
+			for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+			std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {return detail::aggregate_key_less()(keys[a], keys[b]);});
+			for (std::size_t i = 0; i < order.size(); ++i)
+			{
+				if (i == 0 || detail::aggregate_key_less()(keys[order[i - 1]], keys[order[i]])) _keys.push_back(keys[order[i]]);
+				_group[order[i]] = _keys.size() - 1;
+			}
+		}
+
+		const Block_t           *_blocks;
+		std::vector<std::size_t> _group;
+		std::vector<Key_t>       _keys;
+	};
+
+
+	// Divide blocks into groups by the value of a key property.
+	template<typename Block_t, typename Property_t>
+	grouping<Block_t, detail::aggregate_value_t<Property_t>> group_by(const Block_t *blocks, std::size_t count, Property_t Block_t::*key)
+	{
+		return {blocks, count, key};
+	}
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_AGGREGATE_H
@@ -0,0 +1,128 @@
+#ifndef EDB_PROPERTY_ACCESS_ATOMIC_H
+#define EDB_PROPERTY_ACCESS_ATOMIC_H
+
+
+/*
+	This header extends proxy properties referring to atomic variables with C++20 wait and notify,
+		which are implemented with futexes on Linux and equivalent primitives elsewhere.
+
+	Properties referring to std::atomic<T> gain the member functions of std::atomic
+		used for waiting and notification, accessible with the dot operator:
+
+		Proxy(std::atomic<int>, stage, pipeline->stage)
+
+		pipe.stage.wait(0);       // blocks while stage == 0
+		pipe.stage = 1;
+		pipe.stage.notify_all();
+
+	Properties referring to property_access::waitable<T> also support set_and_notify,
+		which only makes a notification system call when some thread is waiting.
+		Their wait takes no memory order, since that skipping relies on it being sequentially consistent.
+*/
+
+
+#include "../property_accessor.h"
+
+#if !(__cplusplus >= 202000L || _MSVC_LANG >= 202000L)
+	#error "property_access/atomic.h requires C++20."
+#endif
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace property_access
+{
+	/*
+		An atomic variable which counts its waiters, so that notification may be skipped
+			when there are none.  Assignment and other operators behave as with std::atomic<T>.
+	*/
+	template<typename T>
+	class waitable
+	{
+	public:
+		waitable() noexcept = default;
+		constexpr waitable(T value) noexcept    : _value(value) {}
+
+		waitable(const waitable&)            = delete;
+		waitable &operator=(const waitable&) = delete;
+
+		T    load (std::memory_order order = std::memory_order_seq_cst) const noexcept    {return _value.load(order);}
+		void store(T value, std::memory_order order = std::memory_order_seq_cst) noexcept {_value.store(value, order);}
+
+		operator T() const noexcept       {return _value.load();}
+		T operator=(T value) noexcept     {_value.store(value); return value;}
+
+		T operator+=(T v) noexcept    {return _value += v;}
+		T operator-=(T v) noexcept    {return _value -= v;}
+		T operator&=(T v) noexcept    {return _value &= v;}
+		T operator|=(T v) noexcept    {return _value |= v;}
+		T operator^=(T v) noexcept    {return _value ^= v;}
+		T operator++()    noexcept    {return ++_value;}
+		T operator--()    noexcept    {return --_value;}
+		T operator++(int) noexcept    {return _value++;}
+		T operator--(int) noexcept    {return _value--;}
+
+		/*
+			Block until the value differs from old.
+				There is no memory order argument: registering as a waiter and then loading the value
+				must be sequentially consistent, as must set_and_notify's store and then load of the
+				waiter count, or each side may miss the other and the waiter would never be woken.
+		*/
+		void wait(T old) const noexcept
+		{
+			_waiters.fetch_add(1, std::memory_order_seq_cst);
+			_value.wait(old, std::memory_order_seq_cst);
+			_waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void notify_one() noexcept    {_value.notify_one();}
+		void notify_all() noexcept    {_value.notify_all();}
+
+		// Store a value and wake all waiting threads, if there are any.
+		void set_and_notify(T value) noexcept
+		{
+			_value.store(value, std::memory_order_seq_cst);
+			if (_waiters.load(std::memory_order_seq_cst) != 0) _value.notify_all();
+		}
+
+		bool has_waiters() const noexcept    {return _waiters.load() != 0;}
+
+	private:
+		std::atomic<T>                     _value = T();
+		mutable std::atomic<std::uint32_t> _waiters = 0;
+	};
+
+
+	namespace detail
+	{
+		// Members shared by atomic properties.
+		template<typename T, typename GetSet_t>
+		struct atomic_members
+		{
+			GetSet_t _property_getset;
+
+			T    load (std::memory_order order = std::memory_order_seq_cst) const    {return _property_getset.get().load(order);}
+			void store(T value, std::memory_order order = std::memory_order_seq_cst) {_property_getset.get().store(value, order);}
+
+			void wait(T old, std::memory_order order = std::memory_order_seq_cst) const    {_property_getset.get().wait(old, order);}
+			void notify_one() const    {_property_getset.get().notify_one();}
+			void notify_all() const    {_property_getset.get().notify_all();}
+		};
+	}
+
+	template<typename T, typename GetSet_t>
+	struct members<std::atomic<T>, GetSet_t> : detail::atomic_members<T, GetSet_t>
+	{
+	};
+
+	template<typename T, typename GetSet_t>
+	struct members<waitable<T>, GetSet_t> : detail::atomic_members<T, GetSet_t>
+	{
+		void wait(T old) const                {this->_property_getset.get().wait(old);}
+		void set_and_notify(T value) const    {this->_property_getset.get().set_and_notify(value);}
+	};
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_ATOMIC_H
@@ -0,0 +1,146 @@
+#ifndef EDB_PROPERTY_ACCESS_AWAITABLE_H
+#define EDB_PROPERTY_ACCESS_AWAITABLE_H
+
+
+/*
+	This header implements properties whose changes can be awaited by C++20 coroutines.
+
+		co_await property_access::changed(job.state);                                    // resumes after the next set.
+		auto s = co_await property_access::until(job.state, [](int s) {return s >= 3;}); // resumes once the predicate holds.
+
+	Waiters are kept in an intrusive list headed by a change_signal in the actual struct.
+		Each list node lives in the awaiting coroutine's frame, so waiting does not allocate.
+		Only properties declared with the Awaitable kind (or a custom getter/setter providing
+		_property_signal()) carry a signal.
+
+	Signals are not thread-safe; setters and waiters should run on the same thread or executor.
+		A coroutine must not be destroyed while it is suspended waiting on a signal.
+*/
+
+
+#include "../property_accessor.h"
+
+#if !(__cplusplus >= 202000L || _MSVC_LANG >= 202000L)
+	#error "property_access/awaitable.h requires C++20."
+#endif
+
+#include <coroutine>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Awaitable(TYPE, NAME, VARIABLE, SIGNAL)  -- Read-write value property whose changes can be awaited.
+
+		TYPE     -- the type of the property.
+		NAME     -- the name of this property accessor.
+		VARIABLE -- the variable in ACTUAL_STRUCT holding the value.
+		SIGNAL   -- a property_access::change_signal in ACTUAL_STRUCT, notified by each set.
+
+		e.g:
+
+			struct Job
+			{
+				struct State {int state; property_access::change_signal state_changed;};
+
+				PropertyAccessors(State,
+					Awaitable(int, status, state, state_changed)
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Awaitable(TYPE, NAME, VARIABLE, SIGNAL) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (VARIABLE);}  void set(const TYPE &value) {(VARIABLE) = value; (SIGNAL).notify();} \
+		const property_access::change_signal &_property_signal() const {return (SIGNAL);}  };
+	#define EDB_PropertyAccessors_Union_Awaitable(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Awaitable(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	/*
+		An intrusive list of coroutines waiting for a property to change.
+			Like a mutex, a signal may be used through a const reference.
+	*/
+	class change_signal
+	{
+	public:
+		struct waiter
+		{
+			waiter                 *next  = nullptr;
+			std::coroutine_handle<> handle;
+			bool                  (*ready)(waiter*) = nullptr;  // If set, the waiter is only resumed when this returns true.
+		};
+
+		change_signal() = default;
+		change_signal(const change_signal&)            = delete;
+		change_signal &operator=(const change_signal&) = delete;
+
+		bool has_waiters() const    {return _head != nullptr;}
+
+		void wait(waiter &w) const    {w.next = _head; _head = &w;}
+
+		// Resume all waiters, except those whose ready() function returns false.
+		void notify() const
+		{
+			waiter *w = _head;
+			_head = nullptr;
+			while (w)
+			{
+				waiter *next = w->next;
+				if (!w->ready || w->ready(w)) w->handle.resume();
+				else wait(*w);
+				w = next;
+			}
+		}
+
+	private:
+		mutable waiter *_head = nullptr;
+	};
+
+
+	namespace detail
+	{
+		template<typename Property_t>
+		const change_signal &property_signal(const Property_t &p)    {return p._property_getset._property_signal();}
+
+		template<typename Property_t>
+		struct change_awaiter : change_signal::waiter
+		{
+			const change_signal &signal;
+
+			bool await_ready() const noexcept                 {return false;}
+			void await_suspend(std::coroutine_handle<> h)     {handle = h; signal.wait(*this);}
+			void await_resume() const noexcept                {}
+		};
+
+		template<typename Property_t, typename Pred>
+		struct until_awaiter : change_signal::waiter
+		{
+			const Property_t &property;
+			Pred              pred;
+
+			bool await_ready() const                          {return pred(property._property_get());}
+			void await_suspend(std::coroutine_handle<> h)
+			{
+				handle = h;
+				ready  = [](change_signal::waiter *w) {auto *self = static_cast<until_awaiter*>(w); return bool(self->pred(self->property._property_get()));};
+				property_signal(property).wait(*this);
+			}
+			auto await_resume() const                         {return property._property_get();}
+		};
+	}
+
+
+	// Await the next assignment to an awaitable property.
+	template<typename GetSet_t>
+	auto changed(const property<GetSet_t> &p)    {return detail::change_awaiter<property<GetSet_t>>{{}, detail::property_signal(p)};}
+
+	// Await until pred(value) is true for an awaitable property, returning the value.  Does not suspend if it is already true.
+	template<typename GetSet_t, typename Pred>
+	auto until(const property<GetSet_t> &p, Pred pred)    {return detail::until_awaiter<property<GetSet_t>, Pred>{{}, p, std::move(pred)};}
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_AWAITABLE_H
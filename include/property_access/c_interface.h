@@ -0,0 +1,124 @@
+#ifndef EDB_PROPERTY_ACCESS_C_INTERFACE_H
+#define EDB_PROPERTY_ACCESS_C_INTERFACE_H
+
+
+/*
+	This header generates C-compatible descriptor tables for reflectable property blocks,
+		allowing foreign runtimes (Lua, Python, C# etc) to read and write numeric properties
+		with one indirect call through a function pointer and no marshaling layer.
+
+	Each descriptor holds a property's name, a type code, and getter and setter thunks which
+		copy the value to or from a variable of the corresponding C type.  Properties of other
+		types are listed with the type EDB_PROPERTY_OTHER and null thunks.
+
+	The table types are declared in edb_property.h, which C code can include.  C++ code passes
+		the table to the C side:
+
+		const edb_property_table *table = property_access::c_property_table<Virtual_Rect>();
+
+		// ...in C, with #include <property_access/edb_property.h>:
+		int width;
+		size_t i;
+		for (i = 0; i < table->count; ++i)
+			if (table->properties[i].name && !strcmp(table->properties[i].name, "width")) table->properties[i].get(vrect, &width);
+
+	The thunks are instantiated from templates, so they are C++ functions rather than extern "C"
+		functions; they are called through C function pointer types.  This is ABI-compatible with C
+		on all common platforms, whose C and C++ calling conventions are the same.
+*/
+
+
+#include "../property_accessor.h"
+#include "edb_property.h"
+
+#include <cstddef>
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		template<typename T> constexpr edb_property_type c_type_code()
+		{
+			if      constexpr (std::is_same_v<T, bool>)   return EDB_PROPERTY_BOOL;
+			else if constexpr (std::is_same_v<T, float>)  return EDB_PROPERTY_FLOAT;
+			else if constexpr (std::is_same_v<T, double>) return EDB_PROPERTY_DOUBLE;
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+			{
+				if constexpr (sizeof(T) == 1) return EDB_PROPERTY_INT8;  else if constexpr (sizeof(T) == 2) return EDB_PROPERTY_INT16;
+				else if constexpr (sizeof(T) == 4) return EDB_PROPERTY_INT32; else if constexpr (sizeof(T) == 8) return EDB_PROPERTY_INT64;
+				else return EDB_PROPERTY_OTHER;
+			}
+			else if constexpr (std::is_integral_v<T>)
+			{
+				if constexpr (sizeof(T) == 1) return EDB_PROPERTY_UINT8;  else if constexpr (sizeof(T) == 2) return EDB_PROPERTY_UINT16;
+				else if constexpr (sizeof(T) == 4) return EDB_PROPERTY_UINT32; else if constexpr (sizeof(T) == 8) return EDB_PROPERTY_UINT64;
+				else return EDB_PROPERTY_OTHER;
+			}
+			else return EDB_PROPERTY_OTHER;
+		}
+
+		// Whether a value property accessor can be assigned a value of type T.
+		template<typename Property_t, typename T, typename = void>
+		struct has_value_setter : public std::bool_constant<false> {};
+		template<typename Property_t, typename T>
+		struct has_value_setter<Property_t, T, std::void_t<decltype(std::declval<Property_t&>()._property_set(std::declval<T>()))>> : public std::bool_constant<true> {};
+
+		// Whether a property accessor can be assigned a value of type T.
+		template<typename Property_t, typename T>
+		constexpr bool is_settable()
+		{
+			if constexpr (Property_t::_property_by_proxy) return !std::is_const_v<std::remove_reference_t<typename Property_t::_property_get_t>>;
+			else return has_value_setter<Property_t, T>::value;
+		}
+
+		template<typename Block_t, std::size_t I>
+		using c_property_t = std::remove_pointer_t<std::tuple_element_t<I, property_fields_t<Block_t>>>;
+
+		template<typename Block_t, std::size_t I>
+		using c_value_t = std::decay_t<typename c_property_t<Block_t, I>::_property_get_t>;
+
+		template<typename Block_t, std::size_t I>
+		void c_get(const void *block, void *value_out)
+		{
+			*static_cast<c_value_t<Block_t, I>*>(value_out) = std::get<I>(static_cast<const Block_t*>(block)->_property_fields())->_property_get();
+		}
+
+		template<typename Block_t, std::size_t I>
+		void c_set(void *block, const void *value_in)
+		{
+			std::get<I>(static_cast<Block_t*>(block)->_property_fields())->_property_set(*static_cast<const c_value_t<Block_t, I>*>(value_in));
+		}
+
+		template<typename Block_t, std::size_t I>
+		edb_property_descriptor c_describe()
+		{
+			using value_t = c_value_t<Block_t, I>;
+			constexpr edb_property_type type = c_type_code<value_t>();
+			const char *name = getset_name<std::decay_t<decltype(std::declval<c_property_t<Block_t, I>&>()._property_getset)>>::value;
+
+			if constexpr (type == EDB_PROPERTY_OTHER) return {name, type, nullptr, nullptr};
+			else if constexpr (!is_settable<c_property_t<Block_t, I>, value_t>()) return {name, type, &c_get<Block_t, I>, nullptr};
+			else return {name, type, &c_get<Block_t, I>, &c_set<Block_t, I>};
+		}
+
+		template<typename Block_t, std::size_t... I>
+		const edb_property_table *c_property_table(std::index_sequence<I...>)
+		{
+			static const edb_property_descriptor properties[sizeof...(I) + 1] = {c_describe<Block_t, I>()..., {}};
+			static const edb_property_table      table = {sizeof...(I), properties};
+			return &table;
+		}
+	}
+
+
+	// Get the C descriptor table for a reflectable property block.  The table is created on first use.
+	template<typename Block_t>
+	const edb_property_table *c_property_table()
+	{
+		return detail::c_property_table<Block_t>(std::make_index_sequence<property_count_v<Block_t>>());
+	}
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_C_INTERFACE_H
@@ -0,0 +1,222 @@
+#ifndef EDB_PROPERTY_ACCESS_CHECKPOINT_H
+#define EDB_PROPERTY_ACCESS_CHECKPOINT_H
+
+
+/*
+	This header implements checkpoints of arrays of property blocks, for rollback and similar uses.
+
+		property_access::checkpoint_arena arena;
+		auto cp = property_access::checkpoint(players, player_count, arena);
+		...
+		property_access::restore(players, cp);
+		arena.reset();                           // once checkpoints are no longer needed.
+
+	If a block's actual struct is trivially copyable and it has no proxy properties, its storage is
+		copied with memcpy, as one run when the blocks are laid out contiguously without padding.
+		Note that this copies pointers held by the actual struct, not what they point to.
+	Otherwise, each settable property is saved separately.  Proxy properties, which refer to
+		their storage, are always saved through that reference, copying what it refers to with memcpy.
+		The values of other properties are captured through their getters and restored through their setters.
+		All of these values must be trivially copyable.
+
+	Checkpoint data is bump-allocated from an arena, whose memory is reused after reset().
+*/
+
+
+#include "c_interface.h"
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+
+namespace property_access
+{
+	/*
+		A bump allocator for checkpoint data.  Memory is released all at once by reset(),
+			and kept for reuse until the arena is destroyed.
+	*/
+	class checkpoint_arena
+	{
+	public:
+		explicit checkpoint_arena(std::size_t chunk_size = std::size_t(1) << 20)    : _chunk_size(chunk_size) {}
+
+		checkpoint_arena(const checkpoint_arena&)            = delete;
+		checkpoint_arena &operator=(const checkpoint_arena&) = delete;
+
+		void *allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+		{
+			for (;; ++_current, _offset = 0)
+			{
+				if (_current == _chunks.size())
+					_chunks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[std::max(_chunk_size, size + align)]), std::max(_chunk_size, size + align)});
+
+				chunk &c = _chunks[_current];
+				auto base = reinterpret_cast<std::uintptr_t>(c.data.get());
+				std::size_t offset = ((base + _offset + align - 1) & ~std::uintptr_t(align - 1)) - base;
+				if (offset + size <= c.size)
+				{
+					_offset = offset + size;
+					return c.data.get() + offset;
+				}
+			}
+		}
+
+		// Invalidate all checkpoints allocated from this arena.
+		void reset() noexcept    {_current = 0; _offset = 0;}
+
+	private:
+		struct chunk
+		{
+			std::unique_ptr<unsigned char[]> data;
+			std::size_t                      size;
+		};
+
+		std::vector<chunk> _chunks;
+		std::size_t        _chunk_size, _current = 0, _offset = 0;
+	};
+
+
+	// Saved state for an array of blocks, valid until its arena is reset.
+	template<typename Block_t>
+	struct block_checkpoint
+	{
+		const unsigned char *data  = nullptr;
+		std::size_t          count = 0;
+	};
+
+
+	namespace detail
+	{
+		template<typename Block_t>
+		using checkpoint_actual_t = decltype(std::declval<Block_t&>()._property_actual);
+
+		template<typename Block_t, std::size_t... I>
+		constexpr bool checkpoint_has_proxy(std::index_sequence<I...>)    {return (false || ... || c_property_t<Block_t, I>::_property_by_proxy);}
+
+		// Blocks with proxies are saved property by property, so a proxy always saves what it refers to.
+		template<typename Block_t>
+		static constexpr bool checkpoint_by_memcpy = std::is_trivially_copyable_v<checkpoint_actual_t<Block_t>>
+			&& !checkpoint_has_proxy<Block_t>(std::make_index_sequence<property_count_v<Block_t>>());
+
+		template<typename Property_t>
+		constexpr bool is_checkpointed()    {return is_settable<Property_t, std::decay_t<typename Property_t::_property_get_t>>();}
+
+		// Whether a property's storage is reachable through its getter, so it can be copied directly.
+		template<typename Property_t>
+		constexpr bool is_checkpointed_directly()
+		{
+			if constexpr (Property_t::_property_by_proxy) return is_checkpointed<Property_t>() && std::is_trivially_copyable_v<std::decay_t<typename Property_t::_property_get_t>>;
+			else return false;
+		}
+
+		constexpr std::size_t checkpoint_align(std::size_t offset, std::size_t align)    {return (offset + align - 1) & ~(align - 1);}
+
+		// The size of one block's saved property values.
+		template<typename Block_t, std::size_t... I>
+		constexpr std::size_t checkpoint_size(std::index_sequence<I...>)
+		{
+			std::size_t size = 0;
+			((size = is_checkpointed<c_property_t<Block_t, I>>()
+				? checkpoint_align(size, alignof(c_value_t<Block_t, I>)) + sizeof(c_value_t<Block_t, I>) : size), ...);
+			return checkpoint_align(size, alignof(std::max_align_t));
+		}
+
+		template<typename Block_t>
+		static constexpr std::size_t checkpoint_size_v = checkpoint_size<Block_t>(std::make_index_sequence<property_count_v<Block_t>>());
+
+		template<typename Block_t, std::size_t I>
+		void checkpoint_save(const Block_t &block, unsigned char *out, std::size_t &offset)
+		{
+			using value_t = c_value_t<Block_t, I>;
+			if constexpr (is_checkpointed<c_property_t<Block_t, I>>())
+			{
+				static_assert(std::is_trivially_copyable_v<value_t>, "Checkpointed property values must be trivially copyable.");
+				offset = checkpoint_align(offset, alignof(value_t));
+				if constexpr (is_checkpointed_directly<c_property_t<Block_t, I>>())
+					std::memcpy(out + offset, std::addressof(std::get<I>(block._property_fields())->_property_get()), sizeof(value_t));
+				else
+				{
+					value_t v = std::get<I>(block._property_fields())->_property_get();
+					std::memcpy(out + offset, std::addressof(v), sizeof(value_t));
+				}
+				offset += sizeof(value_t);
+			}
+		}
+
+		template<typename Block_t, std::size_t I>
+		void checkpoint_load(Block_t &block, const unsigned char *in, std::size_t &offset)
+		{
+			using value_t = c_value_t<Block_t, I>;
+			if constexpr (is_checkpointed<c_property_t<Block_t, I>>())
+			{
+				offset = checkpoint_align(offset, alignof(value_t));
+				if constexpr (is_checkpointed_directly<c_property_t<Block_t, I>>())
+					std::memcpy(std::addressof(std::get<I>(block._property_fields())->_property_get()), in + offset, sizeof(value_t));
+				else
+				{
+					value_t v;
+					std::memcpy(std::addressof(v), in + offset, sizeof(value_t));
+					std::get<I>(block._property_fields())->_property_set(v);
+				}
+				offset += sizeof(value_t);
+			}
+		}
+
+		template<typename Block_t, std::size_t... I>
+		void checkpoint_save(const Block_t &block, unsigned char *out, std::index_sequence<I...>)    {std::size_t offset = 0; (checkpoint_save<Block_t, I>(block, out, offset), ...);}
+
+		template<typename Block_t, std::size_t... I>
+		void checkpoint_load(Block_t &block, const unsigned char *in, std::index_sequence<I...>)    {std::size_t offset = 0; (checkpoint_load<Block_t, I>(block, in, offset), ...);}
+	}
+
+
+	// Save the state of count blocks.
+	template<typename Block_t>
+	block_checkpoint<Block_t> checkpoint(const Block_t *blocks, std::size_t count, checkpoint_arena &arena)
+	{
+		using actual_t = detail::checkpoint_actual_t<Block_t>;
+		block_checkpoint<Block_t> cp;
+		cp.count = count;
+
+		if constexpr (detail::checkpoint_by_memcpy<Block_t>)
+		{
+			auto out = static_cast<unsigned char*>(arena.allocate(count * sizeof(actual_t), alignof(actual_t)));
+			if constexpr (sizeof(actual_t) == sizeof(Block_t)) {if (count) std::memcpy(out, std::addressof(blocks[0]._property_actual), count * sizeof(actual_t));}
+			else for (std::size_t i = 0; i < count; ++i) std::memcpy(out + i * sizeof(actual_t), std::addressof(blocks[i]._property_actual), sizeof(actual_t));
+			cp.data = out;
+		}
+		else
+		{
+			constexpr std::size_t size = detail::checkpoint_size_v<Block_t>;
+			auto out = static_cast<unsigned char*>(arena.allocate(count * size));
+			for (std::size_t i = 0; i < count; ++i) detail::checkpoint_save(blocks[i], out + i * size, std::make_index_sequence<property_count_v<Block_t>>());
+			cp.data = out;
+		}
+		return cp;
+	}
+
+	// Restore the state of the blocks saved in a checkpoint.
+	template<typename Block_t>
+	void restore(Block_t *blocks, const block_checkpoint<Block_t> &cp)
+	{
+		using actual_t = detail::checkpoint_actual_t<Block_t>;
+
+		if constexpr (detail::checkpoint_by_memcpy<Block_t>)
+		{
+			if constexpr (sizeof(actual_t) == sizeof(Block_t)) {if (cp.count) std::memcpy(std::addressof(blocks[0]._property_actual), cp.data, cp.count * sizeof(actual_t));}
+			else for (std::size_t i = 0; i < cp.count; ++i) std::memcpy(std::addressof(blocks[i]._property_actual), cp.data + i * sizeof(actual_t), sizeof(actual_t));
+		}
+		else
+		{
+			constexpr std::size_t size = detail::checkpoint_size_v<Block_t>;
+			for (std::size_t i = 0; i < cp.count; ++i) detail::checkpoint_load(blocks[i], cp.data + i * size, std::make_index_sequence<property_count_v<Block_t>>());
+		}
+	}
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_CHECKPOINT_H
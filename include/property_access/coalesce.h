@@ -0,0 +1,243 @@
+#ifndef EDB_PROPERTY_ACCESS_COALESCE_H
+#define EDB_PROPERTY_ACCESS_COALESCE_H
+
+
+/*
+	This header implements properties whose setter is deferred, so that a burst of writes runs it only once.
+
+		property_access::coalesce_queue layout_queue(std::chrono::milliseconds(50));
+		for (...) panel.width = drag_width;                  // only updates a pending value.
+		layout_queue.flush_due();                             // once per frame: relayout with the final width.
+
+	Each property holds a coalescing slot in its actual struct.  Setting the property stores the value
+		in the slot and, on the first set since the last flush, enqueues the slot in its coalesce_queue.
+		Getting the property returns the pending value if there is one.  The real setter runs once,
+		with the final value, when the slot is flushed: by coalesce_queue::flush() at a tick,
+		by coalesce_queue::flush_due() once the queue's window has passed since the first write,
+		or by property_access::flush(obj.prop).
+
+	Queues and slots are not thread-safe.  A queue must outlive the slots attached to it, and destroying
+		a slot discards its pending value, so blocks should flush their slots before destruction.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Coalesce(TYPE, NAME, SLOT, GET_EXPR, SET_PARAM, SET_EXPR)  -- Read-write property with a deferred setter.
+
+		TYPE      -- the type of the property.
+		NAME      -- the name of this property accessor.
+		SLOT      -- the name of a property_access::coalescing<TYPE> member of ACTUAL_STRUCT.
+		GET_EXPR  -- the value of the property when nothing is pending.
+		SET_PARAM -- the parameter of the real setter, such as `int x`.
+		SET_EXPR  -- the real setter, run when the slot is flushed.
+
+		e.g:
+
+			struct Panel
+			{
+				struct State
+				{
+					Widget                             *widget;
+					property_access::coalescing<float>  pending_width;
+				};
+
+				PropertyAccessors(State,
+					Coalesce(float, width, pending_width, widget->width(), float w, widget->relayout(w))
+				);
+
+				Panel(Widget *w, property_access::coalesce_queue &queue) : _property_actual{w} {_property_actual.pending_width.attach(queue);}
+				~Panel() {property_access::flush(width); _property_actual.~State();}
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Coalesce(TYPE, NAME, SLOT, GET_EXPR, SET_PARAM, SET_EXPR) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {if ((SLOT).pending()) return (SLOT).value(); return (GET_EXPR);} \
+		void set(const TYPE &value) {(SLOT).post(value, this, &_property_flush);}  void flush() {(SLOT).flush();} \
+		void _property_apply(SET_PARAM) {(SET_EXPR);} \
+		static void _property_flush(void *getset) {auto &self = *static_cast<_gs_ ## NAME*>(getset);  self._property_apply(self.SLOT.take());}  };
+	#define EDB_PropertyAccessors_Union_Coalesce(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Coalesce(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	class coalesce_queue;
+
+
+	/*
+		The untyped part of a coalescing slot: whether a value is pending, and how to apply it.
+	*/
+	class coalescing_base
+	{
+	public:
+		coalescing_base() = default;
+		explicit coalescing_base(coalesce_queue &queue)    : _queue(&queue) {}
+		inline ~coalescing_base();
+
+		coalescing_base(const coalescing_base&)            = delete;
+		coalescing_base &operator=(const coalescing_base&) = delete;
+
+		// Use a queue for flushes.  A pending value moves to the back of the new queue.
+		inline void attach(coalesce_queue &queue);
+
+		bool pending() const    {return _pending;}
+
+		// Run the real setter now with the pending value, if any.
+		void flush()    {if (_pending) _apply(_getset);}
+
+	protected:
+		// Mark a value pending, enqueuing this slot if it wasn't already.
+		inline void _post(void *getset, void (*apply)(void*));
+
+		// Clear the pending state, removing this slot from its queue.
+		inline void _clear();
+
+	private:
+		friend class coalesce_queue;
+
+		coalesce_queue *_queue   = nullptr;
+		void           *_getset  = nullptr;
+		void          (*_apply)(void*) = nullptr;
+		std::size_t     _ticket  = 0;
+		bool            _pending = false;
+	};
+
+
+	/*
+		A pending value for a Coalesce property.
+	*/
+	template<typename T>
+	class coalescing : public coalescing_base
+	{
+	public:
+		using coalescing_base::coalescing_base;
+
+		const T &value() const    {return _value;}
+
+		// Store a value, to be applied by calling apply(getset) at the next flush.
+		void post(const T &value, void *getset, void (*apply)(void*))    {_value = value; _post(getset, apply);}
+
+		// Remove the pending value, for applying it.
+		T take()    {_clear(); return std::move(_value);}
+
+	private:
+		T _value = T();
+	};
+
+
+	/*
+		Slots with pending values, in the order of their first write since they were last flushed.
+	*/
+	class coalesce_queue
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+		explicit coalesce_queue(clock::duration window = clock::duration::zero())    : _window(window) {}
+
+		coalesce_queue(const coalesce_queue&)            = delete;
+		coalesce_queue &operator=(const coalesce_queue&) = delete;
+
+		clock::duration window() const    {return _window;}
+		bool            empty() const     {return _pending == 0;}
+		std::size_t     size() const      {return _pending;}
+
+		// Flush every slot pending when called.  Values set by the setters remain pending.
+		void flush()    {_flush(_entries.size());}
+
+		// Flush slots whose first pending write is at least one window old.
+		void flush_due(clock::time_point now = clock::now())
+		{
+			clock::time_point cutoff = now - _window;
+			std::size_t end = _first;
+			while (end < _entries.size() && _entries[end].since <= cutoff) ++end;
+			_flush(end);
+		}
+
+	private:
+		friend class coalescing_base;
+
+		struct entry
+		{
+			coalescing_base  *slot;
+			clock::time_point since;
+		};
+
+		std::size_t _push(coalescing_base *slot)
+		{
+			_entries.push_back({slot, clock::now()});
+			++_pending;
+			return _base + _entries.size() - 1;
+		}
+
+		void _forget(std::size_t ticket)    {_entries[ticket - _base].slot = nullptr; --_pending;}
+
+		void _flush(std::size_t end)
+		{
+			// Setters may enqueue slots again, so entries are looked up by index after each one.
+			while (_first < end)
+			{
+				coalescing_base *slot = _entries[_first++].slot;
+				if (slot) slot->flush();
+			}
+
+			// Drop flushed entries once they are at least half of the queue.
+			if (_first * 2 >= _entries.size())
+			{
+				_entries.erase(_entries.begin(), _entries.begin() + _first);
+				_base += _first;
+				_first = 0;
+			}
+		}
+
+		clock::duration    _window;
+		std::vector<entry> _entries;
+		std::size_t        _first = 0, _base = 0, _pending = 0;
+	};
+
+
+	coalescing_base::~coalescing_base()    {if (_pending && _queue) _queue->_forget(_ticket);}
+
+	void coalescing_base::attach(coalesce_queue &queue)
+	{
+		bool pending = _pending;
+		_clear();
+		_queue = &queue;
+		if (pending) _post(_getset, _apply);
+	}
+
+	void coalescing_base::_post(void *getset, void (*apply)(void*))
+	{
+		_getset = getset;
+		_apply  = apply;
+		if (_pending) return;
+		_pending = true;
+		if (_queue) _ticket = _queue->_push(this);
+	}
+
+	void coalescing_base::_clear()
+	{
+		if (!_pending) return;
+		_pending = false;
+		if (_queue) _queue->_forget(_ticket);
+	}
+
+
+	// Run a Coalesce property's real setter now, if a value is pending.
+	template<typename GetSet_t>
+	void flush(property<GetSet_t> &prop)    {prop._property_getset.flush();}
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_COALESCE_H
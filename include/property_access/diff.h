@@ -0,0 +1,72 @@
+#ifndef EDB_PROPERTY_ACCESS_DIFF_H
+#define EDB_PROPERTY_ACCESS_DIFF_H
+
+
+/*
+	This header implements comparison of two property blocks, property by property.
+
+		auto changed = property_access::diff(before, after);   // std::bitset, one bit per property.
+		if (changed.any()) replicate(after, changed);
+
+	Bits are numbered in order of declaration, as with for_each_property.
+		Values whose bytes uniquely represent them are compared with memcmp, in place when
+		a proxy's getter returns a reference.  Other values are compared with ==, or with the
+		getter/setter's equals() method if it has one.  Values which are themselves property blocks
+		are compared by their properties, as their bytes may be pointers to where the data is held.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <bitset>
+#include <cstring>
+
+
+namespace property_access
+{
+	// A set of flags, one for each property of a block.
+	template<typename Block_t>
+	using property_mask = std::bitset<property_count_v<Block_t>>;
+
+
+	namespace detail
+	{
+		template<typename Block_t, std::size_t... I>
+		property_mask<Block_t> diff(const Block_t &a, const Block_t &b, std::index_sequence<I...>);
+
+		template<typename Property_t>
+		bool property_differs(const Property_t &a, const Property_t &b)
+		{
+			using getset_t = std::decay_t<decltype(a._property_getset)>;
+			using value_t  = std::decay_t<typename Property_t::_property_get_t>;
+			if constexpr (has_equals<const getset_t, const getset_t&>) return !a._property_getset.equals(b._property_getset);
+			else
+			{
+				const value_t &x = a._property_get(), &y = b._property_get();
+				if constexpr (is_property_block_v<value_t>) return diff(x, y, std::make_index_sequence<property_count_v<value_t>>()).any();
+				else if constexpr (std::has_unique_object_representations_v<value_t>) return std::memcmp(std::addressof(x), std::addressof(y), sizeof(value_t)) != 0;
+				else return !(x == y);
+			}
+		}
+
+		template<typename Block_t, std::size_t... I>
+		property_mask<Block_t> diff(const Block_t &a, const Block_t &b, std::index_sequence<I...>)
+		{
+			auto fa = a._property_fields(), fb = b._property_fields();
+			property_mask<Block_t> changed;
+			((changed[I] = property_differs(*std::get<I>(fa), *std::get<I>(fb))), ...);
+			return changed;
+		}
+	}
+
+
+	// Find which properties of two blocks have different values.
+	template<typename Block_t>
+	property_mask<Block_t> diff(const Block_t &a, const Block_t &b)
+	{
+		return detail::diff(a, b, std::make_index_sequence<property_count_v<Block_t>>());
+	}
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_DIFF_H
@@ -0,0 +1,150 @@
+#ifndef EDB_PROPERTY_ACCESS_DIRTY_PAGES_H
+#define EDB_PROPERTY_ACCESS_DIRTY_PAGES_H
+
+
+/*
+	This header implements page-granular dirty tracking for large arrays of property blocks.  Linux only.
+
+		property_access::dirty_tracker<Particle> tracker(particles, particle_count);
+		tracker.clear();                                      // e.g. after taking a full checkpoint.
+		...                                                   // sets run with no tracking overhead.
+		tracker.for_each_dirty([&](std::size_t first, std::size_t count) {save(particles + first, count);});
+
+	Tracking uses the kernel's soft-dirty page bits, so setters do no extra work.
+		clear() resets the bits by writing to /proc/self/clear_refs, and dirty pages are found
+		by reading the array's entries in /proc/self/pagemap.  Blocks sharing a page with a
+		written block are reported as well.
+
+	Soft-dirty bits belong to the whole process; clearing them for one tracker clears them for all.
+		If the kernel lacks soft-dirty support, is_supported() is false and every block is reported dirty.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace property_access
+{
+	/*
+		Tracks which pages of a memory range have been written since the last clear().
+	*/
+	class dirty_pages
+	{
+	public:
+		dirty_pages(const void *data, std::size_t size)
+			: _page(std::size_t(::sysconf(_SC_PAGESIZE)))
+		{
+			auto begin = reinterpret_cast<std::uintptr_t>(data);
+			_first = begin / _page;
+			_count = size ? (begin + size - 1) / _page - _first + 1 : 0;
+			_pagemap = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+		}
+
+		~dirty_pages()    {if (_pagemap >= 0) ::close(_pagemap);}
+
+		dirty_pages(const dirty_pages&)            = delete;
+		dirty_pages &operator=(const dirty_pages&) = delete;
+
+		bool        is_supported() const    {return _pagemap >= 0 && _supported;}
+		std::size_t page_size() const       {return _page;}
+
+		/*
+			Clear the soft-dirty bits of every page in the process.
+				Kernels built without soft-dirty support accept the request but never set the bits,
+				so a probe variable is written afterwards to check that its page becomes dirty.
+		*/
+		bool clear()
+		{
+			static volatile unsigned char probe;
+
+			int fd = ::open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+			_supported = fd >= 0 && ::write(fd, "4", 1) == 1;
+			if (fd >= 0) ::close(fd);
+
+			probe = probe + 1;
+			std::uint64_t entry = 0;
+			off_t offset = off_t(reinterpret_cast<std::uintptr_t>(&probe) / _page * sizeof(std::uint64_t));
+			_supported = _supported && _pagemap >= 0
+				&& ::pread(_pagemap, &entry, sizeof(entry), offset) == ssize_t(sizeof(entry)) && (entry >> 55) & 1;
+			return _supported;
+		}
+
+		/*
+			Call f(address, bytes) for each run of consecutive dirty pages in the range.
+				The run may extend beyond the range at its ends, up to page boundaries.
+		*/
+		template<typename F>
+		void for_each_dirty(F &&f) const
+		{
+			if (!is_supported()) {if (_count) f(_first * _page, _count * _page); return;}
+
+			constexpr std::size_t batch = 512;
+			std::uint64_t entries[batch];
+			std::size_t run_start = 0, run_length = 0;
+			for (std::size_t i = 0; i < _count; i += batch)
+			{
+				std::size_t n = std::min(batch, _count - i);
+				ssize_t got = ::pread(_pagemap, entries, n * sizeof(std::uint64_t), off_t((_first + i) * sizeof(std::uint64_t)));
+				std::size_t valid = got > 0 ? std::size_t(got) / sizeof(std::uint64_t) : 0;
+				for (std::size_t j = 0; j < n; ++j)
+				{
+					// Bit 55 is the soft-dirty bit.  Pages we couldn't read are assumed dirty.
+					if (j >= valid || (entries[j] >> 55) & 1)
+					{
+						if (!run_length) run_start = i + j;
+						++run_length;
+					}
+					else if (run_length) {f((_first + run_start) * _page, run_length * _page); run_length = 0;}
+				}
+			}
+			if (run_length) f((_first + run_start) * _page, run_length * _page);
+		}
+
+	private:
+		std::size_t _page, _first, _count;
+		int         _pagemap;
+		bool        _supported = false;
+	};
+
+
+	/*
+		Tracks which blocks in an array have been written since the last clear(), by page.
+	*/
+	template<typename Block_t>
+	class dirty_tracker
+	{
+	public:
+		dirty_tracker(const Block_t *blocks, std::size_t count)
+			: _pages(blocks, count * sizeof(Block_t)), _blocks(blocks), _count(count) {}
+
+		bool is_supported() const    {return _pages.is_supported();}
+		bool clear()                 {return _pages.clear();}
+
+		// Call f(first, count) for each run of blocks that may have been written.
+		template<typename F>
+		void for_each_dirty(F &&f) const
+		{
+			auto base = reinterpret_cast<std::uintptr_t>(_blocks);
+			_pages.for_each_dirty([&](std::uintptr_t address, std::size_t bytes)
+			{
+				std::size_t first = address > base ? (address - base) / sizeof(Block_t) : 0;
+				std::size_t last  = std::min(_count, (address + bytes - base + sizeof(Block_t) - 1) / sizeof(Block_t));
+				if (first < last) f(first, last - first);
+			});
+		}
+
+	private:
+		dirty_pages    _pages;
+		const Block_t *_blocks;
+		std::size_t    _count;
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_DIRTY_PAGES_H
@@ -0,0 +1,253 @@
+#ifndef EDB_PROPERTY_ACCESS_DOCUMENT_PATH_H
+#define EDB_PROPERTY_ACCESS_DOCUMENT_PATH_H
+
+
+/*
+	This header implements properties addressing a value within a document object model,
+		such as a parsed JSON document, using a path like "a.b[3].c".
+
+		settings.volume = 7;          // JsonPath(int, volume, *doc, "audio.volume")
+		int v = settings.volume;
+
+	Paths are parsed at compile time into a sequence of member and index steps.  Reading a property
+		looks up one member or element per step, converts the node to the property's type, and never
+		parses strings or allocates memory.  A missing node reads as a value-initialized TYPE.
+		Setting a property creates missing members and elements along its path, then assigns the node.
+
+	CachedJsonPath properties also remember the resolved node in a path_cache, along with the root
+		and a generation number supplied by the application, which must change whenever nodes may
+		have been moved or erased (eg, when the document is reloaded or restructured, or when a set
+		creates nodes in a document whose containers move their elements as they grow).
+		While the root and generation are unchanged, access is a comparison and a load.
+
+	Nodes are accessed through property_access::document_node<Node_t>, which may be specialized.
+		By default it expects a nlohmann::json-like interface: find(key) and end() for members,
+		size() and node[index] for elements, node[key] and node[index] to create them,
+		node.get<T>() to read a value and assignment to write one.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		JsonPath(TYPE, NAME, ROOT_EXPRESSION, PATH)  -- Read-write property for a value within a document.
+
+		TYPE            -- the type of the value, to which nodes are converted.
+		NAME            -- the name of this property accessor.
+		ROOT_EXPRESSION -- an expression yielding an lvalue reference to the root node, using variables from ACTUAL_STRUCT.
+		PATH            -- a string literal such as "a.b[3].c".  Malformed paths will not compile.
+
+		e.g:
+
+			struct Settings
+			{
+				struct DocPtr {json *doc;};
+
+				PropertyAccessors(DocPtr,
+					JsonPath(int,         volume,     *doc, "audio.volume"),
+					JsonPath(std::string, first_user, *doc, "users[0].name")
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_JsonPath(TYPE, NAME, ROOT_EXPR, PATH) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		static constexpr auto _property_path = property_access::compile_path<property_access::path_length(PATH)>(PATH); \
+		TYPE get() const {return property_access::document_get<TYPE>(property_access::find_path((ROOT_EXPR), _property_path));} \
+		void set(const TYPE &value) {property_access::document_set(property_access::make_path((ROOT_EXPR), _property_path), value);}  };
+	#define EDB_PropertyAccessors_Union_JsonPath(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_JsonPath(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+	/*
+		CachedJsonPath(TYPE, NAME, ROOT_EXPRESSION, PATH, CACHE, GENERATION)  -- JsonPath which caches the resolved node.
+
+		CACHE      -- a property_access::path_cache<NODE_TYPE> variable in ACTUAL_STRUCT.
+		GENERATION -- an expression yielding an integer which changes whenever nodes may have moved or been erased.
+
+		e.g:
+
+			struct Settings
+			{
+				struct DocPtr {Document *doc;  property_access::path_cache<json> _volume;};
+
+				PropertyAccessors(DocPtr,
+					CachedJsonPath(int, volume, doc->root, "audio.volume", _volume, doc->generation)
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_CachedJsonPath(TYPE, NAME, ROOT_EXPR, PATH, CACHE, GENERATION) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		static constexpr auto _property_path = property_access::compile_path<property_access::path_length(PATH)>(PATH); \
+		TYPE get() const {return property_access::document_get<TYPE>((CACHE).find((ROOT_EXPR), _property_path, (GENERATION)));} \
+		void set(const TYPE &value) {property_access::document_set((CACHE).make((ROOT_EXPR), _property_path, (GENERATION)), value);}  };
+	#define EDB_PropertyAccessors_Union_CachedJsonPath(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_CachedJsonPath(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	// One step of a document path: either a member name or an array index.
+	struct path_step
+	{
+		bool             is_index;
+		std::size_t      index;
+		std::string_view key;
+	};
+
+	// A compiled document path with N steps.
+	template<std::size_t N>
+	struct path
+	{
+		path_step steps[N > 0 ? N : 1];
+	};
+
+	namespace detail
+	{
+		// Not constexpr; calling this during constant evaluation reports a malformed path at compile time.
+		inline void path_syntax_error() {}
+
+		/*
+			Parse one step beginning at position i, advancing i past it.
+				The first step is a member name or an index; later steps are ".name" or "[index]".
+		*/
+		constexpr path_step parse_path_step(std::string_view path, std::size_t &i)
+		{
+			if (path[i] == '[')
+			{
+				std::size_t index = 0, digits = 0;
+				for (++i; i < path.size() && path[i] >= '0' && path[i] <= '9'; ++i, ++digits) index = index*10 + std::size_t(path[i]-'0');
+				if (!digits || i == path.size() || path[i] != ']') path_syntax_error();
+				++i;
+				return {true, index, {}};
+			}
+
+			if (path[i] == '.') {if (i == 0) path_syntax_error(); ++i;}
+			else if (i != 0) path_syntax_error();
+
+			std::size_t start = i;
+			while (i < path.size() && path[i] != '.' && path[i] != '[') ++i;
+			if (i == start) path_syntax_error();
+			return {false, 0, path.substr(start, i-start)};
+		}
+	}
+
+	// Count the steps in a document path.
+	constexpr std::size_t path_length(std::string_view path)
+	{
+		std::size_t n = 0;
+		for (std::size_t i = 0; i < path.size(); ++n) detail::parse_path_step(path, i);
+		return n;
+	}
+
+	// Parse a document path into N steps.  Use with path_length to parse at compile time.
+	template<std::size_t N>
+	constexpr path<N> compile_path(std::string_view p)
+	{
+		path<N> result = {};
+		std::size_t i = 0;
+		for (std::size_t n = 0; n < N; ++n) result.steps[n] = detail::parse_path_step(p, i);
+		return result;
+	}
+
+	/*
+		How nodes of a document are accessed.  Specialize for node types without a nlohmann::json-like interface.
+	*/
+	template<typename Node_t, typename = void>
+	struct document_node
+	{
+		// Find a member or element, or return nullptr.  These must not allocate.
+		static Node_t *member(Node_t &node, std::string_view key)    {auto it = node.find(key); return it == node.end() ? nullptr : &*it;}
+		static Node_t *element(Node_t &node, std::size_t index)      {return index < node.size() ? &node[index] : nullptr;}
+
+		// Find a member or element, creating it if it is missing.
+		static Node_t &make_member(Node_t &node, std::string_view key)    {return node[key];}
+		static Node_t &make_element(Node_t &node, std::size_t index)      {return node[index];}
+
+		template<typename T>
+		static T    get(const Node_t &node)                 {return node.template get<T>();}
+		template<typename T>
+		static void set(Node_t &node, const T &value)       {node = value;}
+	};
+
+	// Resolve a compiled path, starting from the given root node.  Returns nullptr if a node is missing.
+	template<typename Node_t, std::size_t N>
+	Node_t *find_path(Node_t &root, const path<N> &p)
+	{
+		Node_t *node = &root;
+		for (std::size_t n = 0; n < N && node; ++n)
+		{
+			const path_step &step = p.steps[n];
+			if (step.is_index) node = document_node<Node_t>::element(*node, step.index);
+			else               node = document_node<Node_t>::member (*node, step.key);
+		}
+		return node;
+	}
+
+	// Resolve a compiled path, starting from the given root node, creating missing nodes.
+	template<typename Node_t, std::size_t N>
+	Node_t &make_path(Node_t &root, const path<N> &p)
+	{
+		Node_t *node = &root;
+		for (std::size_t n = 0; n < N; ++n)
+		{
+			const path_step &step = p.steps[n];
+			Node_t *next = step.is_index ? document_node<Node_t>::element(*node, step.index) : document_node<Node_t>::member(*node, step.key);
+			if (!next) next = step.is_index ? &document_node<Node_t>::make_element(*node, step.index) : &document_node<Node_t>::make_member(*node, step.key);
+			node = next;
+		}
+		return *node;
+	}
+
+	// Convert a node to a value, or give a value-initialized T if the node is missing.
+	template<typename T, typename Node_t>
+	T document_get(const Node_t *node)    {return node ? document_node<std::remove_const_t<Node_t>>::template get<T>(*node) : T();}
+
+	template<typename T, typename Node_t>
+	void document_set(Node_t &node, const T &value)    {document_node<Node_t>::set(node, value);}
+
+	/*
+		A node resolved from a path, reused while the root and generation number are unchanged.
+			Missing nodes are not cached, so a path is looked up again until it exists.
+	*/
+	template<typename Node_t>
+	class path_cache
+	{
+	public:
+		template<std::size_t N>
+		Node_t *find(Node_t &root, const path<N> &p, std::uint64_t generation) const
+		{
+			if (_valid(root, generation)) return _node;
+			Node_t *node = find_path(root, p);
+			if (node) _remember(node, root, generation);
+			return node;
+		}
+
+		template<std::size_t N>
+		Node_t &make(Node_t &root, const path<N> &p, std::uint64_t generation) const
+		{
+			if (_valid(root, generation)) return *_node;
+			Node_t &node = make_path(root, p);
+			_remember(&node, root, generation);
+			return node;
+		}
+
+		void clear() const    {_node = nullptr;}
+
+	private:
+		bool _valid(Node_t &root, std::uint64_t generation) const    {return _node && _root == &root && _generation == generation;}
+		void _remember(Node_t *node, Node_t &root, std::uint64_t generation) const    {_node = node; _root = &root; _generation = generation;}
+
+		mutable Node_t       *_node = nullptr, *_root = nullptr;
+		mutable std::uint64_t _generation = 0;
+	};
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_DOCUMENT_PATH_H
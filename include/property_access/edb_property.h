@@ -0,0 +1,69 @@
+#ifndef EDB_PROPERTY_ACCESS_EDB_PROPERTY_H
+#define EDB_PROPERTY_ACCESS_EDB_PROPERTY_H
+
+
+/*
+	C declarations of the property descriptor tables generated by c_interface.h.
+		This header may be included from C (C89 or later) as well as C++, eg by the C side of a scripting bridge.
+
+	e.g:
+
+		#include <property_access/edb_property.h>
+
+		int get_width(const edb_property_table *table, const void *vrect)
+		{
+			int width = 0;
+			size_t i;
+			for (i = 0; i < table->count; ++i)
+				if (table->properties[i].name && !strcmp(table->properties[i].name, "width")) table->properties[i].get(vrect, &width);
+			return width;
+		}
+*/
+
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	typedef enum edb_property_type
+	{
+		EDB_PROPERTY_OTHER = 0,
+		EDB_PROPERTY_BOOL,
+		EDB_PROPERTY_INT8,  EDB_PROPERTY_INT16,  EDB_PROPERTY_INT32,  EDB_PROPERTY_INT64,
+		EDB_PROPERTY_UINT8, EDB_PROPERTY_UINT16, EDB_PROPERTY_UINT32, EDB_PROPERTY_UINT64,
+		EDB_PROPERTY_FLOAT, EDB_PROPERTY_DOUBLE
+	}
+	edb_property_type;
+
+	/* Copy a property's value to a variable of the C type given by its type code. */
+	typedef void (*edb_property_getter)(const void *block, void *value_out);
+
+	/* Assign a property's value from a variable of the C type given by its type code. */
+	typedef void (*edb_property_setter)(void *block, const void *value_in);
+
+	typedef struct edb_property_descriptor
+	{
+		const char          *name;  /* null if the block was declared without the PropertyAccessors macro. */
+		edb_property_type    type;
+		edb_property_getter  get;   /* null if type is OTHER. */
+		edb_property_setter  set;   /* null if read-only or type is OTHER. */
+	}
+	edb_property_descriptor;
+
+	typedef struct edb_property_table
+	{
+		size_t                         count;
+		const edb_property_descriptor *properties;
+	}
+	edb_property_table;
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* EDB_PROPERTY_ACCESS_EDB_PROPERTY_H */
@@ -0,0 +1,135 @@
+#ifndef EDB_PROPERTY_ACCESS_EXPIRING_H
+#define EDB_PROPERTY_ACCESS_EXPIRING_H
+
+
+/*
+	This header implements value properties which revert to a default after a time-to-live.
+
+		session.token    = property_access::ttl(token, std::chrono::minutes(30));
+		player.cooldown  = property_access::ttl(true, std::chrono::seconds(5));
+		if (!player.cooldown) ...                                                   // false again after 5 seconds.
+
+	Each value is stored with a deadline, and get() compares the deadline with a coarse clock.
+		There is no background sweeper and no timer per property; expiry costs one clock read
+		per get.  Assigning a value without ttl() stores it with no deadline, while compound assignments
+		and increments modify the value in place and keep its deadline.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <ctime>
+#include <chrono>
+#include <utility>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Expiring(TYPE, NAME, VARIABLE, DEFAULT)  -- Read-write value property which expires.
+
+		TYPE     -- the type of the property.
+		NAME     -- the name of this property accessor.
+		VARIABLE -- a property_access::expiring<TYPE> variable in ACTUAL_STRUCT.
+		DEFAULT  -- the value of the property while unset or expired.
+
+		e.g:
+
+			struct Player
+			{
+				struct State {property_access::expiring<bool> cooling_down;};
+
+				PropertyAccessors(State,
+					Expiring(bool, cooldown, cooling_down, false)
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Expiring(TYPE, NAME, VARIABLE, DEFAULT) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (VARIABLE).get_or(DEFAULT);} \
+		void set(const TYPE &value) {(VARIABLE).set(value);}  void set(const property_access::timed<TYPE> &value) {(VARIABLE).set(value.value, value.ttl);} \
+		template<typename F> void modify(F f) {(VARIABLE).modify(f, DEFAULT);}  };
+	#define EDB_PropertyAccessors_Union_Expiring(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Expiring(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	/*
+		A steady clock with a resolution of a few milliseconds, which is cheaper to read than
+			std::chrono::steady_clock where the platform offers one (CLOCK_MONOTONIC_COARSE on Linux).
+	*/
+	struct coarse_clock
+	{
+		using duration   = std::chrono::nanoseconds;
+		using rep        = duration::rep;
+		using period     = duration::period;
+		using time_point = std::chrono::time_point<coarse_clock>;
+		static constexpr bool is_steady = true;
+
+		static time_point now() noexcept
+		{
+		#if defined(CLOCK_MONOTONIC_COARSE)
+			timespec ts;
+			::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+			return time_point(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+		#else
+			return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+		#endif
+		}
+	};
+
+
+	// A value paired with a time-to-live, for assignment to an Expiring property.
+	template<typename T>
+	struct timed
+	{
+		T                      value;
+		coarse_clock::duration ttl;
+	};
+
+	template<typename T, typename Rep, typename Period>
+	timed<std::decay_t<T>> ttl(T &&value, std::chrono::duration<Rep, Period> ttl)
+	{
+		return {std::forward<T>(value), std::chrono::duration_cast<coarse_clock::duration>(ttl)};
+	}
+
+
+	/*
+		A value which expires at a deadline.  Initially it is unset, which is treated as expired.
+	*/
+	template<typename T>
+	class expiring
+	{
+	public:
+		expiring() = default;
+
+		bool expired() const    {return coarse_clock::now() >= _deadline;}
+
+		// The value, or a fallback if it has expired.
+		template<typename D>
+		T get_or(D &&fallback) const    {if (expired()) return T(std::forward<D>(fallback)); return _value;}
+
+		// Set a value which never expires.
+		void set(const T &value)    {_value = value; _deadline = coarse_clock::time_point::max();}
+
+		// Set a value which expires after a time-to-live.
+		void set(const T &value, coarse_clock::duration ttl)    {_value = value; _deadline = coarse_clock::now() + ttl;}
+
+		// Apply f to the value in place, keeping its deadline.  An expired value is first reset to a fallback with no deadline.
+		template<typename F, typename D>
+		void modify(F &&f, D &&fallback)    {if (expired()) set(T(std::forward<D>(fallback))); f(_value);}
+
+		void clear()    {_deadline = coarse_clock::time_point::min();}
+
+		coarse_clock::time_point deadline() const    {return _deadline;}
+
+	private:
+		T                        _value    = T();
+		coarse_clock::time_point _deadline = coarse_clock::time_point::min();
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_EXPIRING_H
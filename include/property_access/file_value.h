@@ -0,0 +1,207 @@
+#ifndef EDB_PROPERTY_ACCESS_FILE_VALUE_H
+#define EDB_PROPERTY_ACCESS_FILE_VALUE_H
+
+
+/*
+	This header implements properties backed by small text files holding one number,
+		such as sysfs/procfs tunables or daemon configuration files.  POSIX only.
+
+	Values are parsed with from_chars and cached.  A cached value is trusted for a polling interval,
+		after which the file's modification time and size are checked with a single fstat;
+		the file is only read and parsed again if they have changed.  By default the polling interval
+		is one second; with an interval of zero, every get() makes that fstat.  A file which couldn't
+		be parsed isn't read again until it changes either.
+		Files on pseudo-filesystems (sysfs, procfs, cgroupfs and the like, detected with fstatfs on Linux),
+		and other files reporting a size of zero, have no meaningful size or modification time,
+		so they are re-read after every polling interval.
+		Setting a value writes it through with a single pwrite and caches it; a regular file
+		is also truncated to the written text, in case another writer left it longer.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <chrono>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+	#include <sys/vfs.h>
+#endif
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		FileValue(TYPE, NAME, FILE)  -- Read-write value property backed by a file.
+
+		TYPE -- an arithmetic type.
+		NAME -- the name of this property accessor.
+		FILE -- a property_access::file_value<TYPE> variable in ACTUAL_STRUCT.
+
+		e.g:
+
+			struct Tunables
+			{
+				struct Files {property_access::file_value<int> _swappiness{"/proc/sys/vm/swappiness", std::chrono::seconds(1)};};
+
+				PropertyAccessors(Files,
+					FileValue(int, swappiness, _swappiness)
+				);
+
+				Tunables() : _property_actual() {}
+				~Tunables() {_property_actual.~Files();}
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_FileValue(TYPE, NAME, FILE) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME)  TYPE get() const {return (FILE).get();}  void set(const TYPE &value) {(FILE).set(value);}  };
+	#define EDB_PropertyAccessors_Union_FileValue(TYPE, NAME, ...)  property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_FileValue(TYPE, NAME, ...)  , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	/*
+		A cached numeric value stored as text in a file.
+			If the file can't be opened or parsed, the last good value (initially zero) is returned.
+	*/
+	template<typename T>
+	class file_value
+	{
+	public:
+		static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "file_value requires a numeric type.");
+
+		using clock = std::chrono::steady_clock;
+
+		/*
+			Open the file at the given path.
+				poll_interval is how long a cached value is trusted before checking the file again.
+		*/
+		explicit file_value(const char *path, clock::duration poll_interval = std::chrono::seconds(1))
+			:
+			_fd(::open(path, O_RDWR | O_CLOEXEC)), _interval(poll_interval)
+		{
+			if (_fd < 0) _fd = ::open(path, O_RDONLY | O_CLOEXEC);
+			if (_fd < 0) return;
+
+			struct stat info;
+			_regular = ::fstat(_fd, &info) == 0 && S_ISREG(info.st_mode);
+			_pseudo  = _is_pseudo_filesystem(_fd);
+		}
+		~file_value()    {if (_fd >= 0) ::close(_fd);}
+
+		file_value(const file_value&)            = delete;
+		file_value &operator=(const file_value&) = delete;
+
+		bool is_open() const    {return _fd >= 0;}
+
+		// Get the value, reading the file only if it may have changed.
+		T get() const
+		{
+			if (_fd >= 0 && (!_checked || clock::now() >= _next_poll)) _revalidate();
+			return _value;
+		}
+
+		// Write a value through to the file and cache it.  Returns false on failure.
+		bool set(const T &value)
+		{
+			char text[64];
+			auto [end, error] = std::to_chars(text, text + sizeof(text) - 1, value);
+			if (error != std::errc()) return false;
+			*end++ = '\n';
+
+			// Another writer may have left longer text than was last read, so always truncate.
+			const auto length = end - text;
+			if (_fd < 0 || ::pwrite(_fd, text, length, 0) != length) return false;
+			if (_regular && ::ftruncate(_fd, length) != 0) return false;
+
+			// Trust the written value for a polling interval.  The file's modification time has changed,
+			//    so the first check after that reads it again.
+			_value     = value;
+			_checked   = true;
+			_size      = length;
+			_mtime_sec = _mtime_nsec = -1;
+			_next_poll = clock::now() + _interval;
+			return true;
+		}
+
+		// Discard the cached value so the next get() reads the file.
+		void refresh()    {_invalidate();}
+
+	private:
+		void _invalidate()    {_checked = false;}
+
+		// Whether a file is on a filesystem whose files don't report meaningful sizes and modification times.
+		static bool _is_pseudo_filesystem(int fd)
+		{
+#if defined(__linux__)
+			struct statfs fs;
+			if (::fstatfs(fd, &fs) != 0) return false;
+			switch ((unsigned long) fs.f_type)
+			{
+			case 0x9fa0:      // procfs
+			case 0x62656572:  // sysfs
+			case 0x27e0eb:    // cgroup
+			case 0x63677270:  // cgroup2
+			case 0x64626720:  // debugfs
+			case 0x74726163:  // tracefs
+			case 0x62656570:  // configfs
+			case 0x73636673:  // securityfs
+				return true;
+			default:
+				return false;
+			}
+#else
+			(void) fd;
+			return false;
+#endif
+		}
+
+		void _revalidate() const
+		{
+			struct stat info;
+			if (::fstat(_fd, &info) != 0) return;
+
+#if defined(__APPLE__)
+			const auto mtime = info.st_mtimespec;
+#else
+			const auto mtime = info.st_mtim;
+#endif
+			_next_poll = clock::now() + _interval;
+			if (_checked && !_pseudo && info.st_size != 0 && info.st_size == _size && mtime.tv_sec == _mtime_sec && mtime.tv_nsec == _mtime_nsec) return;
+
+			// Remember the file as checked even if it can't be parsed, so it isn't read again until it changes.
+			_checked    = true;
+			_size       = info.st_size;
+			_mtime_sec  = mtime.tv_sec;
+			_mtime_nsec = mtime.tv_nsec;
+
+			char text[64];
+			const auto length = ::pread(_fd, text, sizeof(text), 0);
+			if (length <= 0) return;
+
+			const char *begin = text, *end = text + length;
+			while (begin != end && (*begin == ' ' || *begin == '\t')) ++begin;
+			T value;
+			if (std::from_chars(begin, end, value).ec != std::errc()) return;
+			_value = value;
+		}
+
+		int               _fd;
+		clock::duration   _interval;
+		mutable clock::time_point _next_poll = {};
+		mutable T         _value      = T();
+		mutable bool      _checked    = false;
+		bool              _regular    = false;
+		bool              _pseudo     = false;
+		mutable off_t     _size       = 0;
+		mutable long long _mtime_sec  = 0;
+		mutable long long _mtime_nsec = 0;
+	};
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_FILE_VALUE_H
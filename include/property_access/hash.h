@@ -0,0 +1,164 @@
+#ifndef EDB_PROPERTY_ACCESS_HASH_H
+#define EDB_PROPERTY_ACCESS_HASH_H
+
+
+/*
+	This header implements hashing of property blocks by the values of their properties.
+
+		std::size_t h = property_access::hash(key);                            // all properties.
+		std::size_t k = property_access::hash_of<&Key::x, &Key::y>(key);       // a subset.
+
+		EDB_PropertyHash(Key)                                                   // at global scope: std::hash<Key>.
+
+	Values whose bytes uniquely represent them (integers, enums, pointers and unpadded aggregates)
+		are gathered into a small buffer and hashed in bulk, eight bytes at a time in four independent
+		lanes which compilers can vectorize.  Other values, such as floating point numbers and strings,
+		are hashed with std::hash and mixed in.  Getter/setters with a hash() method are hashed with it,
+		without materializing their values.  Values which are themselves property blocks are hashed
+		by their properties, as their bytes may be pointers to where the data is held.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		EDB_PropertyHash(TYPE)  -- Specialize std::hash for a property block, hashing all its properties.
+			Must be used at global scope.
+	*/
+	#define EDB_PropertyHash(TYPE) namespace std {template<> struct hash<TYPE> {std::size_t operator()(const TYPE &block) const {return property_access::hash(block);}};}
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		/*
+			A streaming hash over bytes.  Input is buffered into 32-byte stripes,
+				each mixed into four 64-bit lanes.
+		*/
+		class block_hasher
+		{
+		public:
+			void update(const void *data, std::size_t size)
+			{
+				auto p = static_cast<const unsigned char*>(data);
+				_length += size;
+				if (_used)
+				{
+					std::size_t n = size < 32 - _used ? size : 32 - _used;
+					std::memcpy(_buffer + _used, p, n);
+					_used += n; p += n; size -= n;
+					if (_used < 32) return;
+					_stripe(_buffer);
+					_used = 0;
+				}
+				for (; size >= 32; p += 32, size -= 32) _stripe(p);
+				std::memcpy(_buffer, p, size);
+				_used = size;
+			}
+
+			// Mix in a hash computed elsewhere.
+			void mix(std::uint64_t h)    {update(&h, sizeof(h));}
+
+			std::uint64_t finish()
+			{
+				if (_used) {std::memset(_buffer + _used, 0, 32 - _used); _stripe(_buffer);}
+				std::uint64_t h = _length * 0x9E3779B97F4A7C15ull;
+				for (std::uint64_t lane : _lanes) h = _fmix(h ^ lane);
+				return h;
+			}
+
+		private:
+			static std::uint64_t _rotl(std::uint64_t x, int r)    {return (x << r) | (x >> (64 - r));}
+			static std::uint64_t _fmix(std::uint64_t k)
+			{
+				k ^= k >> 33; k *= 0xFF51AFD7ED558CCDull;
+				k ^= k >> 33; k *= 0xC4CEB9FE1A85EC53ull;
+				return k ^ (k >> 33);
+			}
+
+			void _stripe(const unsigned char *p)
+			{
+				for (int i = 0; i < 4; ++i)
+				{
+					std::uint64_t w;
+					std::memcpy(&w, p + 8 * i, 8);
+					_lanes[i] = _rotl(_lanes[i] ^ (w * 0x87C37B91114253D5ull), 31) * 0x4CF5AD432745937Full;
+				}
+			}
+
+			std::uint64_t _lanes[4] = {0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull};
+			std::uint64_t _length = 0;
+			std::size_t   _used   = 0;
+			unsigned char _buffer[32];
+		};
+
+		template<typename Property_t>
+		void hash_property(block_hasher &hasher, const Property_t &p)
+		{
+			using value_t = std::decay_t<typename Property_t::_property_get_t>;
+			if constexpr (has_hash<const std::decay_t<decltype(p._property_getset)>>) hasher.mix(p._property_getset.hash());
+			else
+			{
+				const value_t &value = p._property_get();
+				if constexpr (is_property_block_v<value_t>) std::apply([&hasher](auto*... q) {(hash_property(hasher, *q), ...);}, value._property_fields());
+				else if constexpr (std::has_unique_object_representations_v<value_t>) hasher.update(std::addressof(value), sizeof(value_t));
+				else hasher.mix(std::hash<value_t>()(value));
+			}
+		}
+	}
+
+
+	// Hash the value of a property accessor, using its getter/setter's hash() method if it has one.
+	template<typename GetSet_t>
+	std::size_t hash_value(const property<GetSet_t> &p)
+	{
+		using value_t = std::decay_t<typename property<GetSet_t>::_property_get_t>;
+		if constexpr (detail::has_hash<const GetSet_t>) return std::size_t(p._property_getset.hash());
+		else return std::hash<value_t>()(p._property_get());
+	}
+
+
+	// Hash the values of all properties of a block.
+	template<typename Block_t>
+	std::size_t hash(const Block_t &block)
+	{
+		detail::block_hasher hasher;
+		std::apply([&hasher](auto*... p) {(detail::hash_property(hasher, *p), ...);}, block._property_fields());
+		return std::size_t(hasher.finish());
+	}
+
+	// Hash the values of selected properties of a block, given as member pointers.
+	template<auto... Members, typename Block_t>
+	std::size_t hash_of(const Block_t &block)
+	{
+		detail::block_hasher hasher;
+		(detail::hash_property(hasher, block.*Members), ...);
+		return std::size_t(hasher.finish());
+	}
+}
+
+
+/*
+	std::hash for property accessors hashes their values.
+*/
+namespace std
+{
+	template<typename GetSet_t>
+	struct hash<property_access::property<GetSet_t>>
+	{
+		std::size_t operator()(const property_access::property<GetSet_t> &p) const    {return property_access::hash_value(p);}
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_HASH_H
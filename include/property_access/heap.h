@@ -0,0 +1,214 @@
+#ifndef EDB_PROPERTY_ACCESS_HEAP_H
+#define EDB_PROPERTY_ACCESS_HEAP_H
+
+
+/*
+	This header implements priority properties which keep an intrusive heap up to date.
+
+		property_access::intrusive_heap<double, Timer> timers;
+		timer.deadline = now + 5;          // sifts the timer up or down within the heap, in O(log n).
+		while (!timers.empty() && timers.top_key() <= now) timers.pop()->fire();
+
+	Each keyed block holds a heap_entry in its actual struct, storing its key and its slot in the heap.
+		Changing the key through the property restores the heap order from that slot, so neither
+		removal and reinsertion nor lazy deletion is needed.
+
+	The heap is 4-ary, which halves its depth compared with a binary heap, and stores each key next to
+		its entry pointer so that comparisons don't follow pointers.  Heaps and entries are not thread-safe.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		HeapKeyed(TYPE, NAME, ENTRY)  -- Read-write priority key of an intrusive heap.
+
+		TYPE  -- the key type of ENTRY.
+		NAME  -- the name of this property accessor.
+		ENTRY -- a property_access::heap_entry in ACTUAL_STRUCT.
+
+		e.g:
+
+			struct Timer
+			{
+				struct State {property_access::heap_entry<double, Timer> slot;};
+
+				PropertyAccessors(State,
+					HeapKeyed(double, deadline, slot)
+				);
+
+				Timer(property_access::intrusive_heap<double, Timer> &heap, double deadline)
+					: _property_actual() {_property_actual.slot.join(heap, this, deadline);}
+				~Timer() {_property_actual.~State();}
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_HeapKeyed(TYPE, NAME, ENTRY) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (ENTRY).key();}  void set(const TYPE &value) {(ENTRY).set_key(value);}  };
+	#define EDB_PropertyAccessors_Union_HeapKeyed(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_HeapKeyed(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	template<typename Key_t, typename Item_t, typename Compare = std::less<Key_t>> class intrusive_heap;
+
+
+	/*
+		An item's membership in an intrusive heap.  Entries can't be copied or moved,
+			because the heap refers to them by address.  Destroying an entry removes it from its heap.
+	*/
+	template<typename Key_t, typename Item_t, typename Compare = std::less<Key_t>>
+	class heap_entry
+	{
+	public:
+		heap_entry() = default;
+		~heap_entry()    {leave();}
+
+		heap_entry(const heap_entry&)            = delete;
+		heap_entry &operator=(const heap_entry&) = delete;
+
+		void join(intrusive_heap<Key_t, Item_t, Compare> &heap, Item_t *item, Key_t key)
+		{
+			leave();
+			_heap = &heap; _item = item; _key = std::move(key);
+			heap._push(*this);
+		}
+
+		void leave()    {if (_heap) {_heap->_erase(_slot); _heap = nullptr;}}
+
+		bool         in_heap() const    {return _heap != nullptr;}
+		Item_t      *item() const       {return _item;}
+		const Key_t &key() const        {return _key;}
+
+		void set_key(const Key_t &key)
+		{
+			_key = key;
+			if (_heap) _heap->_update(_slot, key);
+		}
+
+	private:
+		friend class intrusive_heap<Key_t, Item_t, Compare>;
+
+		intrusive_heap<Key_t, Item_t, Compare> *_heap = nullptr;
+		Item_t                                 *_item = nullptr;
+		Key_t                                   _key  = Key_t();
+		std::size_t                             _slot = 0;
+	};
+
+
+	/*
+		A 4-ary heap of entries, whose top is the entry with the least key according to Compare.
+	*/
+	template<typename Key_t, typename Item_t, typename Compare>
+	class intrusive_heap
+	{
+	public:
+		using entry = heap_entry<Key_t, Item_t, Compare>;
+
+		explicit intrusive_heap(Compare compare = Compare())    : _compare(std::move(compare)) {}
+		~intrusive_heap()                                       {for (node &n : _nodes) n.owner->_heap = nullptr;}
+
+		intrusive_heap(const intrusive_heap&)            = delete;
+		intrusive_heap &operator=(const intrusive_heap&) = delete;
+
+		bool        empty() const    {return _nodes.empty();}
+		std::size_t size() const     {return _nodes.size();}
+
+		Item_t      *top() const        {return _nodes.front().owner->_item;}
+		const Key_t &top_key() const    {return _nodes.front().key;}
+
+		// Remove the top entry from the heap and return its item.
+		Item_t *pop()
+		{
+			entry *e = _nodes.front().owner;
+			e->leave();
+			return e->_item;
+		}
+
+	private:
+		friend class heap_entry<Key_t, Item_t, Compare>;
+
+		struct node
+		{
+			Key_t  key;
+			entry *owner;
+		};
+
+		static constexpr std::size_t arity = 4;
+
+		void _place(std::size_t i, node &&n)    {n.owner->_slot = i; _nodes[i] = std::move(n);}
+
+		void _sift_up(std::size_t i)
+		{
+			node n = std::move(_nodes[i]);
+			while (i > 0)
+			{
+				std::size_t parent = (i - 1) / arity;
+				if (!_compare(n.key, _nodes[parent].key)) break;
+				_place(i, std::move(_nodes[parent]));
+				i = parent;
+			}
+			_place(i, std::move(n));
+		}
+
+		void _sift_down(std::size_t i)
+		{
+			node n = std::move(_nodes[i]);
+			for (;;)
+			{
+				std::size_t first = i * arity + 1;
+				if (first >= _nodes.size()) break;
+				std::size_t last = std::min(first + arity, _nodes.size()), best = first;
+				for (std::size_t c = first + 1; c < last; ++c) if (_compare(_nodes[c].key, _nodes[best].key)) best = c;
+				if (!_compare(_nodes[best].key, n.key)) break;
+				_place(i, std::move(_nodes[best]));
+				i = best;
+			}
+			_place(i, std::move(n));
+		}
+
+		void _restore(std::size_t i)
+		{
+			if (i > 0 && _compare(_nodes[i].key, _nodes[(i - 1) / arity].key)) _sift_up(i);
+			else _sift_down(i);
+		}
+
+		void _push(entry &e)
+		{
+			_nodes.push_back({e._key, &e});
+			_sift_up(_nodes.size() - 1);
+		}
+
+		void _update(std::size_t i, const Key_t &key)
+		{
+			_nodes[i].key = key;
+			_restore(i);
+		}
+
+		void _erase(std::size_t i)
+		{
+			node last = std::move(_nodes.back());
+			_nodes.pop_back();
+			if (i == _nodes.size()) return;
+			_place(i, std::move(last));
+			_restore(i);
+		}
+
+		Compare           _compare;
+		std::vector<node> _nodes;
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_HEAP_H
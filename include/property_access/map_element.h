@@ -0,0 +1,151 @@
+#ifndef EDB_PROPERTY_ACCESS_MAP_ELEMENT_H
+#define EDB_PROPERTY_ACCESS_MAP_ELEMENT_H
+
+
+/*
+	This header implements cached references to elements of associative containers,
+		for building property facades over maps (eg, `config.timeout` over a map of settings).
+
+	A map_element is placed in the actual struct of a property block and resolved by a proxy property:
+
+		struct Config
+		{
+			using Settings = property_access::generational_map<std::unordered_map<std::string, Value>>;
+
+			struct Slots {property_access::map_element<Settings> _timeout, _retries;};
+
+			PropertyAccessors(Slots,
+				Proxy(Value, timeout, _timeout.resolve()),
+				Proxy(Value, retries, _retries.resolve())
+			);
+
+			// Slots is not trivially destructible when the key is a std::string.
+			~Config() {_property_actual.~Slots();}
+		};
+
+		Config config = {{{{&settings, "timeout"}, {&settings, "retries"}}}};
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		// Detect a generation counter, which must change whenever the map's elements may have moved or been erased.
+		template<typename Map_t, typename = void> struct map_generation                                                                   {using type = char; static constexpr bool value = false;};
+		template<typename Map_t>                  struct map_generation<Map_t, std::void_t<decltype(std::declval<const Map_t&>().generation())>> {using type = std::decay_t<decltype(std::declval<const Map_t&>().generation())>; static constexpr bool value = true;};
+
+		// Detect lookup with a precalculated hash, as supported by some hash map libraries.
+		template<typename Map_t, typename Key_t, typename = void> struct map_prehashed_find : public std::bool_constant<false> {};
+		template<typename Map_t, typename Key_t>                  struct map_prehashed_find<Map_t, Key_t,
+			std::void_t<decltype(std::declval<Map_t&>().find(std::declval<const Key_t&>(), std::size_t()))>> : public std::bool_constant<true> {};
+
+		template<typename Map_t, typename Key_t>
+		std::size_t map_prehash(const Map_t &map, const Key_t &key)
+		{
+			if constexpr (map_prehashed_find<Map_t, Key_t>::value) return map.hash_function()(key);
+			else return 0;
+		}
+	}
+
+
+	/*
+		A node-based map (such as std::unordered_map or std::map) with a generation counter,
+			which changes whenever elements may have been erased, allowing map_element to cache them.
+			Inserting doesn't change the generation, as it doesn't move the elements of node-based maps.
+			Erasing through a reference to the underlying map type bypasses the counter.
+	*/
+	template<typename Map_t>
+	class generational_map : public Map_t
+	{
+	public:
+		using Map_t::Map_t;
+
+		generational_map() = default;
+		generational_map(const generational_map&) = default;
+		generational_map(generational_map&&)      = default;
+
+		generational_map &operator=(const generational_map &other)    {Map_t::operator=(other);            ++_generation; return *this;}
+		generational_map &operator=(generational_map &&other)         {Map_t::operator=(std::move(other)); ++_generation; ++other._generation; return *this;}
+
+		std::uint64_t generation() const noexcept    {return _generation;}
+
+		template<typename... A> decltype(auto) erase  (A&&... a)    {++_generation; return Map_t::erase  (std::forward<A>(a)...);}
+		template<typename... A> decltype(auto) extract(A&&... a)    {++_generation; return Map_t::extract(std::forward<A>(a)...);}
+
+		void clear() noexcept                    {++_generation; Map_t::clear();}
+		void swap(generational_map &other)       {++_generation; ++other._generation; Map_t::swap(other);}
+
+	private:
+		std::uint64_t _generation = 0;
+	};
+
+
+	/*
+		A reference to one element of an associative container, identified by its key.
+			resolve() returns a reference to the mapped value, inserting a default value if the key is missing.
+
+		If the container provides a generation() method, the resolved element is cached and
+			reused until the generation changes, making repeated access a comparison and a load.
+			Standard containers can be given one by wrapping them in generational_map.
+			Otherwise, each access performs a lookup, like the expression (*map)[key].
+
+		If the container supports find(key, hash), as some hash map libraries do, the key's hash is
+			computed once at construction.  Standard containers have no such lookup, so for them
+			only the caching applies.
+	*/
+	template<typename Map_t, typename Key_t = typename Map_t::key_type>
+	struct map_element
+	{
+		using map_type    = Map_t;
+		using key_type    = Key_t;
+		using mapped_type = typename Map_t::mapped_type;
+
+		static constexpr bool cached   = detail::map_generation<Map_t>::value;
+		static constexpr bool prehashed = detail::map_prehashed_find<Map_t, Key_t>::value;
+
+		map_element(Map_t *_map, Key_t _key)    : map(_map), key(std::move(_key)), hash(detail::map_prehash(*map, key)) {}
+
+		Map_t      *map;
+		Key_t       key;
+		std::size_t hash;
+
+		mapped_type &resolve() const
+		{
+			if constexpr (cached)
+			{
+				auto generation = map->generation();
+				if (_cache && _cache_generation == generation) return *_cache;
+				_cache = &lookup();
+				_cache_generation = generation;
+				return *_cache;
+			}
+			else return lookup();
+		}
+
+	private:
+		mapped_type &lookup() const
+		{
+			if constexpr (prehashed)
+			{
+				auto i = map->find(key, hash);
+				if (i != map->end()) return i->second;
+			}
+			return (*map)[key];
+		}
+
+		mutable mapped_type                                *_cache = nullptr;
+		mutable typename detail::map_generation<Map_t>::type _cache_generation = {};
+	};
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_MAP_ELEMENT_H
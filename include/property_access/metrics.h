@@ -0,0 +1,136 @@
+#ifndef EDB_PROPERTY_ACCESS_METRICS_H
+#define EDB_PROPERTY_ACCESS_METRICS_H
+
+
+/*
+	This header implements a registry exporting property values as metrics
+		in the Prometheus (OpenMetrics) text exposition format.
+
+	Registering a property stores a pointer to it; values are only read through getters when
+		the registry is rendered, so registered properties cost nothing when accessed elsewhere.
+		Properties referring to atomic variables are read with relaxed loads.
+		Properties must outlive the registry, and registration must not overlap rendering.
+
+	e.g:
+
+		property_access::metrics_registry registry;
+		registry.add_block("server_", server_stats);     // every numeric property, named server_<name>
+		registry.add("queue_depth", queue.depth);
+
+		std::string_view text = registry.render();
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <string_view>
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		// Read a metric's value, using a relaxed load for atomic variables.
+		template<typename T>
+		auto metric_value(const T &value)
+		{
+			if constexpr (std::is_arithmetic_v<T>) return value;
+			else return value.load(std::memory_order_relaxed);
+		}
+
+		template<typename T, typename = void> struct is_metric : public std::bool_constant<std::is_arithmetic_v<T>> {};
+		template<typename T>                  struct is_metric<T, std::enable_if_t<!std::is_arithmetic_v<T>, std::void_t<decltype(std::declval<const T&>().load(std::memory_order_relaxed))>>>
+			: public std::bool_constant<std::is_arithmetic_v<decltype(std::declval<const T&>().load(std::memory_order_relaxed))>> {};
+	}
+
+
+	class metrics_registry
+	{
+	public:
+		// Register a property accessor with a numeric or atomic numeric value as a metric.
+		template<typename GetSet_t>
+		void add(std::string_view name, const property<GetSet_t> &p, std::string_view type = "gauge")
+		{
+			std::string header;
+			header.append("# TYPE ").append(name).append(" ").append(type).append("\n").append(name).append(" ");
+			_text.reserve(_text.capacity() + header.size() + 32);
+			_metrics.push_back({std::move(header), std::addressof(p), &_write<property<GetSet_t>>});
+		}
+
+		/*
+			Register every property accessor with a numeric value in a reflectable block, named prefix + property name.
+				Properties without a name (declared without the PropertyAccessors macro) are skipped.
+		*/
+		template<typename Block_t>
+		void add_block(std::string_view prefix, const Block_t &block, std::string_view type = "gauge")
+		{
+			for_each_property(block, [&](const char *name, auto &p)
+			{
+				if constexpr (detail::is_metric<std::decay_t<decltype(p._property_get())>>::value)
+					if (name) add(std::string(prefix).append(name), p, type);
+			});
+		}
+
+		std::size_t size() const    {return _metrics.size();}
+		void        clear()         {_metrics.clear();}
+
+		/*
+			Render all registered metrics in one pass.
+				The returned text is valid until the registry is next modified or rendered.
+				The buffer is reused, so rendering does not allocate once it has grown to size.
+		*/
+		std::string_view render()
+		{
+			_text.clear();
+			for (const metric &m : _metrics)
+			{
+				char value[64];
+				_text.append(m.header).append(value, m.write(m.property, value, value + sizeof(value))).push_back('\n');
+			}
+			return _text;
+		}
+
+	private:
+		using write_fn = char*(*)(const void *property, char *first, char *last);
+
+		struct metric
+		{
+			std::string header;
+			const void *property;
+			write_fn    write;
+		};
+
+		template<typename Property_t>
+		static char *_write(const void *property, char *first, char *last)
+		{
+			const auto &ref = static_cast<const Property_t*>(property)->_property_get();
+			const auto value = detail::metric_value(ref);
+
+			if constexpr (std::is_same_v<std::decay_t<decltype(value)>, bool>)
+			{
+				*first = (value ? '1' : '0');
+				return first + 1;
+			}
+			else if constexpr (std::is_floating_point_v<std::decay_t<decltype(value)>>)
+			{
+				if (std::isnan(value)) return std::copy_n("NaN", 3, first);
+				if (std::isinf(value)) return (value > 0) ? std::copy_n("+Inf", 4, first) : std::copy_n("-Inf", 4, first);
+				return std::to_chars(first, last, value).ptr;
+			}
+			else return std::to_chars(first, last, value).ptr;
+		}
+
+		std::vector<metric> _metrics;
+		std::string         _text;
+	};
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_METRICS_H
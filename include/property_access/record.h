@@ -0,0 +1,276 @@
+#ifndef EDB_PROPERTY_ACCESS_RECORD_H
+#define EDB_PROPERTY_ACCESS_RECORD_H
+
+
+/*
+	This header implements recording of property writes, and replaying them to reproduce a state.  POSIX only.
+
+		property_access::start_recording("writes.log");
+		job.progress = 3;                               // appended to this thread's buffer.
+		property_access::stop_recording();
+
+		property_access::replay_log log("writes.log");
+		log.apply(fresh_job, job_id);                   // applies the writes recorded for job_id, in order.
+
+	Only properties declared with the Recorded kind are recorded.  Each set appends a header
+		(a timestamp, the thread's index and sequence number, block id, accessor id and size) and
+		the value's bytes to a thread-local buffer, which is written to the log with one write call
+		when it fills up, on flush_recording() and when the thread exits.  Sequence numbers are
+		per thread, so recording threads share no counters.  When recording is off, a set costs one relaxed load.
+
+	Buffered entries belong to the log they were recorded for: entries still buffered when
+		a log is stopped are discarded, and are never written to a later log.
+
+	Accessor ids are hashes of property names, so logs remain valid when properties are reordered.
+		Values must be trivially copyable, and are recorded in the machine's native representation.
+*/
+
+
+#include "c_interface.h"
+
+#include <atomic>
+#include <chrono>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Recorded(TYPE, NAME, VARIABLE, BLOCK_ID)  -- Read-write value property whose sets are recorded.
+
+		TYPE     -- a trivially copyable type.
+		NAME     -- the name of this property accessor.
+		VARIABLE -- the variable in ACTUAL_STRUCT holding the value.
+		BLOCK_ID -- an expression giving a std::uint32_t identifying this object in the log.
+
+		e.g:
+
+			struct Job
+			{
+				struct State {std::uint32_t id; int progress;};
+
+				PropertyAccessors(State,
+					Recorded(int, progress, progress, id)
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Recorded(TYPE, NAME, VARIABLE, BLOCK_ID) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (VARIABLE);} \
+		void set(const TYPE &value) {(VARIABLE) = value; property_access::detail::record_write((BLOCK_ID), property_access::detail::record_id(#NAME), value);}  };
+	#define EDB_PropertyAccessors_Union_Recorded(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Recorded(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	// The header of each entry in a recording, followed by size bytes of value.
+	struct record_header
+	{
+		std::uint64_t time;    // steady clock, in nanoseconds.
+		std::uint64_t seq;     // per thread.
+		std::uint32_t thread;
+		std::uint32_t block;
+		std::uint32_t accessor;
+		std::uint32_t size;
+	};
+
+
+	namespace detail
+	{
+		// FNV-1a hash of a property name, used as its accessor id.
+		constexpr std::uint32_t record_id(const char *name)
+		{
+			std::uint32_t h = 2166136261u;
+			while (*name) h = (h ^ static_cast<unsigned char>(*name++)) * 16777619u;
+			return h;
+		}
+
+		struct record_state
+		{
+			std::atomic<int>           fd         = -1;
+			std::atomic<std::uint64_t> generation = 0;  // incremented when a log starts or stops.
+			std::atomic<std::uint32_t> threads    = 0;
+		};
+
+		inline record_state &recording()    {static record_state state; return state;}
+
+		inline void record_write_all(int fd, const unsigned char *data, std::size_t size)
+		{
+			while (size)
+			{
+				ssize_t n = ::write(fd, data, size);
+				if (n <= 0) return;
+				data += n;
+				size -= std::size_t(n);
+			}
+		}
+
+		// A per-thread buffer of recorded writes.
+		class record_buffer
+		{
+		public:
+			record_buffer()     : _thread(recording().threads.fetch_add(1, std::memory_order_relaxed)) {}
+			~record_buffer()    {flush();}
+
+			void flush()
+			{
+				int fd = recording().fd.load(std::memory_order_acquire);
+				_discard_stale();
+				if (fd >= 0 && _used) record_write_all(fd, _data, _used);
+				_used = 0;
+			}
+
+			void append(std::uint32_t block, std::uint32_t accessor, const void *value, std::uint32_t size)
+			{
+				_discard_stale();
+				if (_used + sizeof(record_header) + size > sizeof(_data)) flush();
+				auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+				record_header h = {std::uint64_t(time), _seq++, _thread, block, accessor, size};
+				std::memcpy(_data + _used, &h, sizeof(h));
+				std::memcpy(_data + _used + sizeof(h), value, size);
+				_used += sizeof(h) + size;
+			}
+
+		private:
+			// Drop entries buffered for an earlier log.
+			void _discard_stale()
+			{
+				std::uint64_t generation = recording().generation.load(std::memory_order_acquire);
+				if (_generation != generation) {_used = 0; _generation = generation;}
+			}
+
+			std::uint32_t _thread;
+			std::uint64_t _seq        = 0;
+			std::uint64_t _generation = 0;
+			std::size_t   _used       = 0;
+			unsigned char _data[1 << 16];
+		};
+
+		inline record_buffer &thread_record_buffer()    {thread_local record_buffer buffer; return buffer;}
+
+		template<typename T>
+		void record_write(std::uint32_t block, std::uint32_t accessor, const T &value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Recorded properties must have trivially copyable values.");
+			static_assert(sizeof(record_header) + sizeof(T) <= (1 << 16), "Recorded value is too large.");
+			if (recording().fd.load(std::memory_order_relaxed) < 0) return;
+			thread_record_buffer().append(block, accessor, std::addressof(value), sizeof(T));
+		}
+	}
+
+
+	// Start recording to a file, replacing its contents.  Returns false if it can't be opened.
+	inline bool start_recording(const char *path)
+	{
+		int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+		if (fd < 0) return false;
+		detail::recording().generation.fetch_add(1, std::memory_order_acq_rel);
+		int old = detail::recording().fd.exchange(fd, std::memory_order_acq_rel);
+		if (old >= 0) ::close(old);
+		return true;
+	}
+
+	inline bool is_recording()    {return detail::recording().fd.load(std::memory_order_relaxed) >= 0;}
+
+	// Write out the calling thread's buffered entries.
+	inline void flush_recording()    {detail::thread_record_buffer().flush();}
+
+	/*
+		Flush the calling thread's entries and close the log.
+			Other recording threads should have flushed or exited first, or their entries are discarded.
+	*/
+	inline void stop_recording()
+	{
+		flush_recording();
+		int fd = detail::recording().fd.exchange(-1, std::memory_order_acq_rel);
+		detail::recording().generation.fetch_add(1, std::memory_order_acq_rel);
+		if (fd >= 0) ::close(fd);
+	}
+
+
+	/*
+		A recording loaded for replay.  Entries are merged in the order they were recorded,
+			regardless of the order in which threads flushed them: each thread's entries in sequence,
+			and entries from different threads by timestamp.
+	*/
+	class replay_log
+	{
+	public:
+		struct entry
+		{
+			record_header        header;
+			const unsigned char *value;
+		};
+
+		explicit replay_log(const char *path)
+		{
+			int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+			if (fd < 0) return;
+			unsigned char chunk[1 << 16];
+			for (ssize_t n; (n = ::read(fd, chunk, sizeof(chunk))) > 0;) _data.insert(_data.end(), chunk, chunk + n);
+			::close(fd);
+
+			for (std::size_t pos = 0; pos + sizeof(record_header) <= _data.size();)
+			{
+				entry e;
+				std::memcpy(&e.header, &_data[pos], sizeof(record_header));
+				if (_data.size() - pos - sizeof(record_header) < e.header.size) break;  // Truncated entry
+				e.value = &_data[pos + sizeof(record_header)];
+				_entries.push_back(e);
+				pos += sizeof(record_header) + e.header.size;
+			}
+			// Timestamps never decrease within a thread, so this keeps each thread's entries in sequence.
+			std::sort(_entries.begin(), _entries.end(), [](const entry &a, const entry &b)
+				{return std::tie(a.header.time, a.header.thread, a.header.seq) < std::tie(b.header.time, b.header.thread, b.header.seq);});
+		}
+
+		replay_log(const replay_log&)            = delete;
+		replay_log &operator=(const replay_log&) = delete;
+
+		std::size_t  size() const     {return _entries.size();}
+		const entry *begin() const    {return _entries.data();}
+		const entry *end() const      {return _entries.data() + _entries.size();}
+
+		/*
+			Apply the writes recorded for one block id to a block, through its setters.
+				Entries naming unknown properties or with mismatched sizes are skipped, as are properties
+				without a name (declared without the PropertyAccessors macro).
+				Returns the number of writes applied.
+		*/
+		template<typename Block_t>
+		std::size_t apply(Block_t &block, std::uint32_t block_id) const
+		{
+			std::size_t applied = 0;
+			for (const entry &e : _entries) if (e.header.block == block_id)
+				for_each_property(block, [&](const char *name, auto &p)
+				{
+					using value_t = std::decay_t<decltype(p._property_get())>;
+					if constexpr (std::is_trivially_copyable_v<value_t> && std::is_default_constructible_v<value_t>
+						&& detail::is_settable<std::decay_t<decltype(p)>, value_t>())
+					{
+						if (!name || e.header.size != sizeof(value_t) || detail::record_id(name) != e.header.accessor) return;
+						value_t v;
+						std::memcpy(std::addressof(v), e.value, sizeof(value_t));
+						p = v;
+						++applied;
+					}
+				});
+			return applied;
+		}
+
+	private:
+		std::vector<unsigned char> _data;
+		std::vector<entry>         _entries;
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_RECORD_H
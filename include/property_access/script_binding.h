@@ -0,0 +1,298 @@
+#ifndef EDB_PROPERTY_ACCESS_SCRIPT_BINDING_H
+#define EDB_PROPERTY_ACCESS_SCRIPT_BINDING_H
+
+
+/*
+	This header implements interpreter-agnostic script bindings for reflectable property blocks.
+
+	Each block type has a static binding_table listing its numeric properties by interned name,
+		with thunks to get, assign or compound-assign them using boxed script values.
+		An interpreter interns property names once (eg, when compiling a script) and keeps
+		a binding_cache at each property access site in its bytecode.  A cache hit costs a
+		pointer comparison followed by an indirect call.
+
+	e.g:
+
+		// When compiling `entity.health -= 5`
+		const char *name = property_access::intern("health");
+		property_access::binding_cache cache;
+
+		// When executing it
+		const binding_table &table = property_access::binding_table::of<Entity>();
+		if (auto *entry = cache.find(table, name))
+			entry->apply(&entity, property_access::script_op::subtract, property_access::script_value(5));
+*/
+
+
+#include "c_interface.h"
+
+#include <cmath>
+#include <mutex>
+#include <limits>
+#include <string>
+#include <climits>
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+
+
+namespace property_access
+{
+	// A boxed value as exchanged with an interpreter.
+	struct script_value
+	{
+		enum kind_t : std::uint8_t {nil, boolean, integer, number};
+
+		kind_t kind;
+		union
+		{
+			bool         b;
+			std::int64_t i;
+			double       d;
+		};
+
+		script_value()                  : kind(nil), i(0) {}
+		script_value(bool         v)    : kind(boolean), b(v) {}
+		script_value(int          v)    : kind(integer), i(v) {}
+		script_value(std::int64_t v)    : kind(integer), i(v) {}
+		script_value(double       v)    : kind(number),  d(v) {}
+
+		template<typename T>
+		static script_value box(T v)
+		{
+			if      constexpr (std::is_same_v<T, bool>) return script_value(v);
+			else if constexpr (std::is_integral_v<T>)   return script_value(std::int64_t(v));
+			else                                        return script_value(double(v));
+		}
+
+		/*
+			Convert to a numeric type.  Returns false if the value is nil, if it is converted
+				to an integer type which can't represent it (including NaN and infinities),
+				or if it is a finite number beyond the range of a narrower floating point type.
+		*/
+		template<typename T>
+		bool unbox(T &out) const
+		{
+			switch (kind)
+			{
+			case boolean: out = T(b); return true;
+			case integer:
+				if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+					if (i < std::int64_t(std::numeric_limits<T>::min()) || (i > 0 && std::uint64_t(i) > std::uint64_t(std::numeric_limits<T>::max()))) return false;
+				out = T(i); return true;
+			case number:
+				if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+				{
+					// The representable range is [min, max + 1), whose bounds are exact powers of two.
+					double limit = std::ldexp(1.0, std::numeric_limits<T>::digits);
+					if (!(d >= (std::is_signed_v<T> ? -limit : 0.0) && d < limit)) return false;
+				}
+				else if constexpr (std::is_floating_point_v<T> && sizeof(T) < sizeof(double))
+					if (std::isfinite(d) && std::fabs(d) > double(std::numeric_limits<T>::max())) return false;
+				out = T(d); return true;
+			default:      return false;
+			}
+		}
+	};
+
+	enum class script_op : std::uint8_t
+	{
+		assign, add, subtract, multiply, divide, modulo,
+		shift_left, shift_right, bit_and, bit_or, bit_xor
+	};
+
+	/*
+		Intern a string, returning a pointer which is identical for all equal strings.
+			Interned strings are never freed.  Thread-safe.
+	*/
+	inline const char *intern(std::string_view name)
+	{
+		static std::mutex                      mutex;
+		static std::unordered_set<std::string> strings;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		return strings.emplace(name).first->c_str();
+	}
+
+	// A bound property.
+	struct binding_entry
+	{
+		const char   *name;  // interned
+		script_value (*get)(const void *block);
+		bool         (*apply)(void *block, script_op op, const script_value &value);  // false if unsupported.
+	};
+
+	// Bindings for all numeric properties of a reflectable block type.
+	class binding_table
+	{
+	public:
+		template<typename Block_t>
+		static const binding_table &of();
+
+		// Find a property by interned name, or return nullptr.
+		const binding_entry *find(const char *interned_name) const
+		{
+			for (std::size_t i = 0; i < _count; ++i) if (_entries[i].name == interned_name) return &_entries[i];
+			return nullptr;
+		}
+
+		const binding_entry *begin() const    {return _entries;}
+		const binding_entry *end()   const    {return _entries + _count;}
+
+	private:
+		binding_table(const binding_entry *entries, std::size_t count)    : _entries(entries), _count(count) {}
+
+		template<typename Block_t, std::size_t... I>
+		static const binding_table &_create(std::index_sequence<I...>);
+
+		const binding_entry *_entries;
+		std::size_t          _count;
+	};
+
+	/*
+		An inline cache for one property access site in a script.
+			Remembers the result of the last lookup along with the table and name it was made with.
+	*/
+	class binding_cache
+	{
+	public:
+		const binding_entry *find(const binding_table &table, const char *interned_name)
+		{
+			if (&table == _table && interned_name == _name) return _entry;
+			_table = &table;
+			_name  = interned_name;
+			return (_entry = table.find(interned_name));
+		}
+
+	private:
+		const binding_table *_table = nullptr;
+		const char          *_name  = nullptr;
+		const binding_entry *_entry = nullptr;
+	};
+
+
+	namespace detail
+	{
+		// Whether a signed arithmetic operation would overflow T.
+		template<typename T>
+		bool script_overflows(script_op op, T a, T b)
+		{
+			constexpr T min = std::numeric_limits<T>::min(), max = std::numeric_limits<T>::max();
+			switch (op)
+			{
+			case script_op::add:        return b > 0 ? a > max - b : a < min - b;
+			case script_op::subtract:   return b < 0 ? a > max + b : a < min + b;
+			case script_op::multiply:
+				if (a == 0 || b == 0) return false;
+				if (a > 0) return b > 0 ? a > max / b : b < min / a;
+				else       return b > 0 ? a < min / b : b < max / a;
+			case script_op::shift_left: return a > (max >> b);
+			default:                    return false;
+			}
+		}
+
+		template<typename Block_t, std::size_t I>
+		script_value script_get(const void *block)
+		{
+			return script_value::box(std::get<I>(static_cast<const Block_t*>(block)->_property_fields())->_property_get());
+		}
+
+		template<typename Block_t, std::size_t I>
+		bool script_apply(void *block, script_op op, const script_value &boxed)
+		{
+			using value_t = c_value_t<Block_t, I>;
+
+			auto &p = *std::get<I>(static_cast<Block_t*>(block)->_property_fields());
+			value_t v;
+			if (!boxed.unbox(v)) return false;
+
+			// Reject integer operations whose behavior is undefined, including signed overflow.
+			if constexpr (std::is_integral_v<value_t> && !std::is_same_v<value_t, bool>) switch (op)
+			{
+			case script_op::divide:
+			case script_op::modulo:
+				if (v == 0) return false;
+				if constexpr (std::is_signed_v<value_t>) if (v == -1 && p._property_get() == std::numeric_limits<value_t>::min()) return false;
+				break;
+			case script_op::shift_left:
+			case script_op::shift_right:
+				if (v < 0 || std::size_t(v) >= sizeof(value_t) * CHAR_BIT) return false;
+				if constexpr (std::is_signed_v<value_t>) if (op == script_op::shift_left && p._property_get() < 0) return false;
+				break;
+			default: break;
+			}
+			if constexpr (std::is_integral_v<value_t> && std::is_signed_v<value_t>)
+				if (script_overflows<value_t>(op, p._property_get(), v)) return false;
+
+			if constexpr (std::is_same_v<value_t, bool>)
+			{
+				if (op != script_op::assign) return false;
+				p = v;
+			}
+			else switch (op)
+			{
+			case script_op::assign:   p  = v; break;
+			case script_op::add:      p += v; break;
+			case script_op::subtract: p -= v; break;
+			case script_op::multiply: p *= v; break;
+			case script_op::divide:   p /= v; break;
+			default:
+				if constexpr (std::is_integral_v<value_t>) switch (op)
+				{
+				case script_op::modulo:      p %=  v; break;
+				case script_op::shift_left:  p <<= v; break;
+				case script_op::shift_right: p >>= v; break;
+				case script_op::bit_and:     p &=  v; break;
+				case script_op::bit_or:      p |=  v; break;
+				case script_op::bit_xor:     p ^=  v; break;
+				default: return false;
+				}
+				else return false;
+			}
+			return true;
+		}
+
+		// Describe a property, or return a null entry if it is not numeric.
+		template<typename Block_t, std::size_t I>
+		binding_entry script_describe()
+		{
+			using property_t = c_property_t<Block_t, I>;
+			using value_t    = c_value_t<Block_t, I>;
+
+			if constexpr (c_type_code<value_t>() == EDB_PROPERTY_OTHER) return {};
+			else
+			{
+				constexpr const char *raw_name = getset_name<std::decay_t<decltype(std::declval<property_t&>()._property_getset)>>::value;
+
+				// Properties without a name (declared without the PropertyAccessors macro) can't be bound.
+				if constexpr (raw_name == nullptr) return {};
+				else if constexpr (is_settable<property_t, value_t>()) return {intern(raw_name), &script_get<Block_t, I>, &script_apply<Block_t, I>};
+				else return {intern(raw_name), &script_get<Block_t, I>, [](void*, script_op, const script_value&) {return false;}};
+			}
+		}
+	}
+
+
+	template<typename Block_t, std::size_t... I>
+	const binding_table &binding_table::_create(std::index_sequence<I...>)
+	{
+		static binding_entry entries[sizeof...(I) + 1] = {detail::script_describe<Block_t, I>()..., {}};
+		static const binding_table table = []
+		{
+			// Keep only numeric properties.
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < sizeof...(I); ++i) if (entries[i].get) entries[count++] = entries[i];
+			return binding_table(entries, count);
+		}();
+		return table;
+	}
+
+	template<typename Block_t>
+	const binding_table &binding_table::of()
+	{
+		return _create<Block_t>(std::make_index_sequence<property_count_v<Block_t>>());
+	}
+}
+
+
+#endif // EDB_PROPERTY_ACCESS_SCRIPT_BINDING_H
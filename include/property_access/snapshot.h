@@ -0,0 +1,275 @@
+#ifndef EDB_PROPERTY_ACCESS_SNAPSHOT_H
+#define EDB_PROPERTY_ACCESS_SNAPSHOT_H
+
+
+/*
+	This header implements consistent snapshots of in-memory property blocks using fork().  POSIX only.
+
+		auto snap = property_access::fork_snapshot(store_lock, "store.snap", [&](property_access::snapshot_writer &out)
+		{
+			out.write_blocks(accounts, account_count);
+		});
+		...                   // the parent keeps mutating; the child sees memory as it was at the fork.
+		snap.wait();
+
+	The child process serializes blocks through their getters while the kernel shares memory
+		with the parent copy-on-write, so the parent pays only for the pages it writes meanwhile.
+		The snapshot is written to a temporary file which is renamed over the path on success,
+		and the directory is synced so that the rename survives a crash.
+
+	fork() copies only the calling thread.  For the snapshot to be consistent across blocks, other
+		threads should hold a lock in shared mode while they mutate; the overload taking a lock
+		holds it exclusively around fork() alone.  The serializer runs in the forked child of a
+		possibly multi-threaded process, so it should avoid locks and heap allocation, including
+		in getters.  snapshot_writer buffers without allocating.
+
+	Values are saved for each settable property whose value is trivially copyable,
+		in the machine's native representation.  snapshot_reader restores them through setters.
+*/
+
+
+#include "c_interface.h"
+
+#include <mutex>
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		template<typename Property_t>
+		constexpr bool is_snapshotted()
+		{
+			using value_t = std::decay_t<typename Property_t::_property_get_t>;
+			return std::is_trivially_copyable_v<value_t> && std::is_default_constructible_v<value_t> && is_settable<Property_t, value_t>();
+		}
+
+		// fsync the directory containing path, so that a rename into it is durable.
+		inline bool sync_parent_directory(const char *path)
+		{
+			const char *slash = std::strrchr(path, '/');
+			std::string dir = !slash ? std::string(".") : slash == path ? std::string("/") : std::string(path, slash);
+			int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (fd < 0) return false;
+			bool ok = ::fsync(fd) == 0;
+			return ::close(fd) == 0 && ok;
+		}
+	}
+
+
+	// Buffered output to a snapshot file.
+	class snapshot_writer
+	{
+	public:
+		explicit snapshot_writer(int fd)    : _fd(fd) {}
+
+		snapshot_writer(const snapshot_writer&)            = delete;
+		snapshot_writer &operator=(const snapshot_writer&) = delete;
+
+		bool ok() const    {return _ok;}
+
+		void write(const void *data, std::size_t size)
+		{
+			auto bytes = static_cast<const unsigned char*>(data);
+			while (size)
+			{
+				if (_used == sizeof(_buffer)) flush();
+				std::size_t n = std::min(size, sizeof(_buffer) - _used);
+				std::memcpy(_buffer + _used, bytes, n);
+				_used += n; bytes += n; size -= n;
+			}
+		}
+
+		// Write the value of each settable, trivially copyable property of count blocks.
+		template<typename Block_t>
+		void write_blocks(const Block_t *blocks, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				std::apply([this](auto*... p) {(_write_property(*p), ...);}, blocks[i]._property_fields());
+		}
+
+		bool flush()
+		{
+			for (std::size_t done = 0; done < _used && _ok;)
+			{
+				ssize_t n = ::write(_fd, _buffer + done, _used - done);
+				if (n > 0) done += std::size_t(n);
+				else _ok = false;
+			}
+			_used = 0;
+			return _ok;
+		}
+
+	private:
+		template<typename Property_t>
+		void _write_property(const Property_t &p)
+		{
+			if constexpr (detail::is_snapshotted<Property_t>())
+			{
+				std::decay_t<typename Property_t::_property_get_t> value = p._property_get();
+				write(std::addressof(value), sizeof(value));
+			}
+		}
+
+		int           _fd;
+		bool          _ok   = true;
+		std::size_t   _used = 0;
+		unsigned char _buffer[1 << 16];
+	};
+
+
+	// Restores blocks from a snapshot file, in the order they were written.
+	class snapshot_reader
+	{
+	public:
+		explicit snapshot_reader(const char *path)    : _fd(::open(path, O_RDONLY | O_CLOEXEC)) {_ok = _fd >= 0;}
+		~snapshot_reader()                            {if (_fd >= 0) ::close(_fd);}
+
+		snapshot_reader(const snapshot_reader&)            = delete;
+		snapshot_reader &operator=(const snapshot_reader&) = delete;
+
+		bool ok() const    {return _ok;}
+
+		bool read(void *data, std::size_t size)
+		{
+			auto bytes = static_cast<unsigned char*>(data);
+			while (size && _ok)
+			{
+				if (_pos == _size)
+				{
+					ssize_t n = ::read(_fd, _buffer, sizeof(_buffer));
+					if (n <= 0) {_ok = false; break;}
+					_pos = 0; _size = std::size_t(n);
+				}
+				std::size_t n = std::min(size, _size - _pos);
+				std::memcpy(bytes, _buffer + _pos, n);
+				_pos += n; bytes += n; size -= n;
+			}
+			return _ok;
+		}
+
+		// Read count blocks written by snapshot_writer::write_blocks, through their setters.
+		template<typename Block_t>
+		bool read_blocks(Block_t *blocks, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count && _ok; ++i)
+				std::apply([this](auto*... p) {(_read_property(*p), ...);}, blocks[i]._property_fields());
+			return _ok;
+		}
+
+	private:
+		template<typename Property_t>
+		void _read_property(Property_t &p)
+		{
+			if constexpr (detail::is_snapshotted<Property_t>())
+			{
+				std::decay_t<typename Property_t::_property_get_t> value;
+				if (read(std::addressof(value), sizeof(value))) p._property_set(value);
+			}
+		}
+
+		int           _fd;
+		bool          _ok;
+		std::size_t   _pos = 0, _size = 0;
+		unsigned char _buffer[1 << 16];
+	};
+
+
+	/*
+		A snapshot being written by a child process.
+			Destroying a snapshot that hasn't finished waits for it.
+	*/
+	class snapshot
+	{
+	public:
+		snapshot() = default;
+		explicit snapshot(pid_t pid)    : _pid(pid) {}
+		~snapshot()                     {wait();}
+
+		snapshot(snapshot &&other) noexcept    : _pid(other._pid), _status(other._status) {other._pid = -1;}
+		snapshot &operator=(snapshot &&other) noexcept
+		{
+			if (this != &other) {wait(); _pid = other._pid; _status = other._status; other._pid = -1;}
+			return *this;
+		}
+
+		/*
+			Whether the child has finished, without blocking.
+				If it can't be waited for, as when SIGCHLD is ignored and the child was reaped
+				already, it counts as finished without having succeeded.
+		*/
+		bool done()
+		{
+			if (_pid > 0)
+			{
+				pid_t r = ::waitpid(_pid, &_status, WNOHANG);
+				if (r == _pid) _pid = -1;
+				else if (r < 0 && errno != EINTR) {_status = -1; _pid = -1;}
+			}
+			return _pid <= 0;
+		}
+
+		// Wait for the child to finish.  Returns true if the snapshot was written successfully.
+		bool wait()
+		{
+			while (_pid > 0 && ::waitpid(_pid, &_status, 0) != _pid) if (errno != EINTR) {_status = -1; break;}
+			_pid = -1;
+			return succeeded();
+		}
+
+		bool succeeded() const    {return _pid == -1 && _status >= 0 && WIFEXITED(_status) && WEXITSTATUS(_status) == 0;}
+
+	private:
+		pid_t _pid    = -1;
+		int   _status = -1;
+	};
+
+
+	/*
+		Fork a child process which calls serialize(snapshot_writer&) and publishes the file at path.
+			If the fork fails or serialize throws, the returned snapshot has failed.
+	*/
+	template<typename F>
+	snapshot fork_snapshot(const char *path, F &&serialize)
+	{
+		std::string temp = std::string(path) + ".tmp";
+
+		pid_t pid = ::fork();
+		if (pid != 0) return snapshot(pid);
+
+		// Child process
+		int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		bool ok = fd >= 0;
+		if (ok)
+		{
+			snapshot_writer out(fd);
+			try {serialize(out);}
+			catch (...) {::unlink(temp.c_str()); ::_exit(1);}
+			ok = out.flush() && ::fsync(fd) == 0;
+			ok = ::close(fd) == 0 && ok;
+			ok = ok && ::rename(temp.c_str(), path) == 0;
+			if (!ok) ::unlink(temp.c_str());
+			ok = ok && detail::sync_parent_directory(path);
+		}
+		::_exit(ok ? 0 : 1);
+	}
+
+	// Fork a snapshot while holding a lock, so that no other thread is mid-mutation at the fork.
+	template<typename Lock_t, typename F>
+	snapshot fork_snapshot(Lock_t &lock, const char *path, F &&serialize)
+	{
+		std::lock_guard<Lock_t> guard(lock);
+		return fork_snapshot(path, std::forward<F>(serialize));
+	}
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_SNAPSHOT_H
@@ -0,0 +1,157 @@
+#ifndef EDB_PROPERTY_ACCESS_SORT_H
+#define EDB_PROPERTY_ACCESS_SORT_H
+
+
+/*
+	This header implements sorting of arrays of property blocks by one of their properties.
+
+		property_access::sort_by(units, unit_count, &Unit::distance);
+		property_access::sort_by(units, unit_count, &Unit::name, std::greater<>());
+
+	Each block's key is read through its getter exactly once, into an array of (key, index) pairs.
+		Integral, enum and floating point keys are sorted with an LSD radix sort, skipping bytes which
+		are the same in every key; other keys, and sorts with a comparator, use std::stable_sort.
+		The blocks are then permuted in place, moving each block once (or, for blocks which
+		can't be moved, their actual struct, which must then be their only data).
+
+	Sorting is stable.  With radix sorting, -0.0 sorts before 0.0, NaN keys sort after positive infinity,
+		and negative NaNs before negative infinity.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+
+
+namespace property_access
+{
+	namespace detail
+	{
+		template<typename Key_t>
+		static constexpr bool is_radix_key = (std::is_integral_v<Key_t> || std::is_enum_v<Key_t> || std::is_floating_point_v<Key_t>) && sizeof(Key_t) <= 8;
+
+		template<std::size_t Size> struct radix_word;
+		template<> struct radix_word<1> {using type = std::uint8_t;};
+		template<> struct radix_word<2> {using type = std::uint16_t;};
+		template<> struct radix_word<4> {using type = std::uint32_t;};
+		template<> struct radix_word<8> {using type = std::uint64_t;};
+
+		template<typename Key_t, bool = std::is_enum_v<Key_t>> struct radix_integer                {using type = Key_t;};
+		template<typename Key_t>                               struct radix_integer<Key_t, true>    {using type = std::underlying_type_t<Key_t>;};
+		template<typename Key_t>
+		using radix_integer_t = typename radix_integer<Key_t>::type;
+
+		// Map a key to an unsigned integer with the same order.
+		template<typename Key_t>
+		auto radix_bits(Key_t key)
+		{
+			using word_t = typename radix_word<sizeof(Key_t)>::type;
+			constexpr word_t sign = word_t(word_t(1) << (8 * sizeof(Key_t) - 1));
+			word_t w;
+			std::memcpy(&w, &key, sizeof(Key_t));
+			if constexpr (std::is_floating_point_v<Key_t>)                            return word_t((w & sign) ? ~w : (w | sign));
+			else if constexpr (std::is_signed_v<radix_integer_t<Key_t>>)              return word_t(w ^ sign);
+			else                                                                      return w;
+		}
+
+		// Stable LSD radix sort of (bits, index) pairs.
+		template<typename Word_t>
+		void radix_sort(std::vector<std::pair<Word_t, std::size_t>> &items)
+		{
+			std::vector<std::pair<Word_t, std::size_t>> buffer(items.size());
+			for (unsigned shift = 0; shift < 8 * sizeof(Word_t); shift += 8)
+			{
+				std::size_t counts[256] = {};
+				for (auto &item : items) ++counts[(item.first >> shift) & 0xFF];
+				if (std::find(std::begin(counts), std::end(counts), items.size()) != std::end(counts)) continue;  // All keys share this byte
+
+				std::size_t offset = 0;
+				for (std::size_t &c : counts) {std::size_t n = c; c = offset; offset += n;}
+				for (auto &item : items) buffer[counts[(item.first >> shift) & 0xFF]++] = item;
+				items.swap(buffer);
+			}
+		}
+
+		/*
+			Access the part of a block which is moved when sorting: the whole block if it can be moved,
+				or else its actual struct, which must then be the block's only data.
+		*/
+		template<typename Block_t>
+		auto &movable_part(Block_t &block)
+		{
+			if constexpr (std::is_move_constructible_v<Block_t> && std::is_move_assignable_v<Block_t>) return block;
+			else
+			{
+				static_assert(sizeof(block._property_actual) == sizeof(Block_t),
+					"Blocks with members outside the property union must be move-constructible and move-assignable to be sorted.");
+				return block._property_actual;
+			}
+		}
+
+		// Rearrange blocks so that position k receives the block at order[k].
+		template<typename Block_t>
+		void permute_blocks(Block_t *blocks, std::vector<std::size_t> &order)
+		{
+			const std::size_t done = std::size_t(-1);
+			for (std::size_t start = 0; start < order.size(); ++start)
+			{
+				if (order[start] == done || order[start] == start) continue;
+				auto held = std::move(movable_part(blocks[start]));
+				std::size_t k = start;
+				while (order[k] != start)
+				{
+					std::size_t next = order[k];
+					movable_part(blocks[k]) = std::move(movable_part(blocks[next]));
+					order[k] = done;
+					k = next;
+				}
+				movable_part(blocks[k]) = std::move(held);
+				order[k] = done;
+			}
+		}
+	}
+
+
+	// Stably sort blocks by the value of a property, using a comparator.
+	template<typename Block_t, typename Property_t, typename Compare>
+	void sort_by(Block_t *blocks, std::size_t count, Property_t Block_t::*member, Compare compare)
+	{
+		using key_t = std::decay_t<typename Property_t::_property_get_t>;
+		std::vector<std::pair<key_t, std::size_t>> keys;
+		keys.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) keys.emplace_back((blocks[i].*member)._property_get(), i);
+		std::stable_sort(keys.begin(), keys.end(), [&compare](const auto &a, const auto &b) {return compare(a.first, b.first);});
+
+		std::vector<std::size_t> order(count);
+		for (std::size_t i = 0; i < count; ++i) order[i] = keys[i].second;
+		detail::permute_blocks(blocks, order);
+	}
+
+	// Stably sort blocks in ascending order of a property's value.
+	template<typename Block_t, typename Property_t>
+	void sort_by(Block_t *blocks, std::size_t count, Property_t Block_t::*member)
+	{
+		using key_t = std::decay_t<typename Property_t::_property_get_t>;
+		if constexpr (detail::is_radix_key<key_t>)
+		{
+			using word_t = typename detail::radix_word<sizeof(key_t)>::type;
+			std::vector<std::pair<word_t, std::size_t>> keys;
+			keys.reserve(count);
+			for (std::size_t i = 0; i < count; ++i) keys.emplace_back(detail::radix_bits<key_t>((blocks[i].*member)._property_get()), i);
+			detail::radix_sort(keys);
+
+			std::vector<std::size_t> order(count);
+			for (std::size_t i = 0; i < count; ++i) order[i] = keys[i].second;
+			detail::permute_blocks(blocks, order);
+		}
+		else sort_by(blocks, count, member, std::less<>());
+	}
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_SORT_H
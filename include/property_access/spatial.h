@@ -0,0 +1,205 @@
+#ifndef EDB_PROPERTY_ACCESS_SPATIAL_H
+#define EDB_PROPERTY_ACCESS_SPATIAL_H
+
+
+/*
+	This header implements position properties which keep a uniform spatial grid up to date.
+
+		property_access::spatial_grid<float, Agent> grid(0, 0, 4.0f, 256, 256);
+		Agent a(grid, 10, 20);
+		a.x += 3;                                                    // moves between cells only if needed.
+		grid.neighbors(a.x, a.y, 5.0f, [](Agent *other) {...});
+
+	Each indexed block holds a grid_entry in its actual struct, storing its position, its cell and
+		its slot within the cell.  Setting a coordinate recomputes the cell from the new position,
+		and only when it differs is the entry swap-removed from its old cell and appended to the new one.
+		There is no per-frame rebuild.
+
+	Positions outside the grid are clamped into its edge cells, so queries stay correct but slower there.
+		Grids and entries are not thread-safe.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cmath>
+#include <vector>
+#include <cstddef>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		SpatialIndexed(TYPE, NAME, ENTRY, AXIS)  -- Read-write coordinate kept in a spatial grid.
+
+		TYPE  -- the coordinate type of ENTRY.
+		NAME  -- the name of this property accessor.
+		ENTRY -- a property_access::grid_entry in ACTUAL_STRUCT.
+		AXIS  -- 0 for the x coordinate or 1 for the y coordinate.
+
+		e.g:
+
+			struct Agent
+			{
+				struct State {property_access::grid_entry<float, Agent> position;};
+
+				PropertyAccessors(State,
+					SpatialIndexed(float, x, position, 0),
+					SpatialIndexed(float, y, position, 1)
+				);
+
+				Agent(property_access::spatial_grid<float, Agent> &grid, float x, float y)
+					: _property_actual() {_property_actual.position.join(grid, this, x, y);}
+				~Agent() {_property_actual.~State();}
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_SpatialIndexed(TYPE, NAME, ENTRY, AXIS) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (ENTRY).coordinate(AXIS);}  void set(const TYPE &value) {(ENTRY).move_axis((AXIS), value);}  };
+	#define EDB_PropertyAccessors_Union_SpatialIndexed(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_SpatialIndexed(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	template<typename Coord_t, typename Item_t> class spatial_grid;
+
+
+	/*
+		An item's membership in a spatial grid.  Entries can't be copied or moved,
+			because the grid refers to them by address.  Destroying an entry removes it from its grid.
+	*/
+	template<typename Coord_t, typename Item_t>
+	class grid_entry
+	{
+	public:
+		grid_entry() = default;
+		~grid_entry()    {leave();}
+
+		grid_entry(const grid_entry&)            = delete;
+		grid_entry &operator=(const grid_entry&) = delete;
+
+		void join(spatial_grid<Coord_t, Item_t> &grid, Item_t *item, Coord_t x, Coord_t y)
+		{
+			leave();
+			_grid = &grid; _item = item; _position[0] = x; _position[1] = y;
+			grid._insert(*this, grid._cell_of(x, y));
+		}
+
+		void leave()    {if (_grid) {_grid->_remove(*this); _grid = nullptr;}}
+
+		Item_t *item() const                  {return _item;}
+		Coord_t coordinate(int axis) const    {return _position[axis];}
+		Coord_t x() const                     {return _position[0];}
+		Coord_t y() const                     {return _position[1];}
+
+		void move_to(Coord_t x, Coord_t y)
+		{
+			_position[0] = x; _position[1] = y;
+			if (!_grid) return;
+			std::size_t cell = _grid->_cell_of(x, y);
+			if (cell != _cell) {_grid->_remove(*this); _grid->_insert(*this, cell);}
+		}
+
+		void move_axis(int axis, Coord_t value)    {if (axis == 0) move_to(value, _position[1]); else move_to(_position[0], value);}
+
+	private:
+		friend class spatial_grid<Coord_t, Item_t>;
+
+		spatial_grid<Coord_t, Item_t> *_grid = nullptr;
+		Item_t                        *_item = nullptr;
+		Coord_t                        _position[2] = {};
+		std::size_t                    _cell = 0, _slot = 0;
+	};
+
+
+	/*
+		A uniform grid of square cells covering [origin, origin + cell_size * (columns, rows)).
+	*/
+	template<typename Coord_t, typename Item_t>
+	class spatial_grid
+	{
+	public:
+		using entry = grid_entry<Coord_t, Item_t>;
+
+		spatial_grid(Coord_t origin_x, Coord_t origin_y, Coord_t cell_size, std::size_t columns, std::size_t rows)
+			: _origin{origin_x, origin_y}, _cell_size(cell_size), _columns(columns), _rows(rows), _cells(columns * rows) {}
+
+		~spatial_grid()    {for (auto &cell : _cells) for (entry *e : cell) e->_grid = nullptr;}
+
+		spatial_grid(const spatial_grid&)            = delete;
+		spatial_grid &operator=(const spatial_grid&) = delete;
+
+		std::size_t size() const    {return _size;}
+
+		// Call f(item) for each item whose position is within the rectangle, bounds included.
+		template<typename F>
+		void query(Coord_t min_x, Coord_t min_y, Coord_t max_x, Coord_t max_y, F &&f) const
+		{
+			_visit(min_x, min_y, max_x, max_y, [&](const entry &e)
+			{
+				if (e.x() >= min_x && e.x() <= max_x && e.y() >= min_y && e.y() <= max_y) f(e.item());
+			});
+		}
+
+		// Call f(item) for each item within a distance of a point, bounds included.
+		template<typename F>
+		void neighbors(Coord_t x, Coord_t y, Coord_t radius, F &&f) const
+		{
+			_visit(x - radius, y - radius, x + radius, y + radius, [&](const entry &e)
+			{
+				Coord_t dx = e.x() - x, dy = e.y() - y;
+				if (dx * dx + dy * dy <= radius * radius) f(e.item());
+			});
+		}
+
+	private:
+		friend class grid_entry<Coord_t, Item_t>;
+
+		std::size_t _clamp(Coord_t offset, std::size_t count) const
+		{
+			auto i = std::floor(offset / _cell_size);
+			if (!(i > 0)) return 0;  // Also catches NaN
+			return i >= Coord_t(count) ? count - 1 : std::size_t(i);
+		}
+
+		std::size_t _column(Coord_t x) const               {return _clamp(x - _origin[0], _columns);}
+		std::size_t _row   (Coord_t y) const               {return _clamp(y - _origin[1], _rows);}
+		std::size_t _cell_of(Coord_t x, Coord_t y) const   {return _row(y) * _columns + _column(x);}
+
+		// Call f(entry) for each entry in cells overlapping the rectangle.
+		template<typename F>
+		void _visit(Coord_t min_x, Coord_t min_y, Coord_t max_x, Coord_t max_y, F &&f) const
+		{
+			std::size_t c0 = _column(min_x), c1 = _column(max_x), r0 = _row(min_y), r1 = _row(max_y);
+			for (std::size_t r = r0; r <= r1; ++r)
+				for (std::size_t c = c0; c <= c1; ++c)
+					for (const entry *e : _cells[r * _columns + c]) f(*e);
+		}
+
+		void _insert(entry &e, std::size_t cell)
+		{
+			e._cell = cell;
+			e._slot = _cells[cell].size();
+			_cells[cell].push_back(&e);
+			++_size;
+		}
+
+		void _remove(entry &e)
+		{
+			auto &cell = _cells[e._cell];
+			cell[e._slot] = cell.back();
+			cell[e._slot]->_slot = e._slot;
+			cell.pop_back();
+			--_size;
+		}
+
+		Coord_t                          _origin[2], _cell_size;
+		std::size_t                      _columns, _rows, _size = 0;
+		std::vector<std::vector<entry*>> _cells;
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_SPATIAL_H
@@ -0,0 +1,219 @@
+#ifndef EDB_PROPERTY_ACCESS_STATISTICS_H
+#define EDB_PROPERTY_ACCESS_STATISTICS_H
+
+
+/*
+	This header implements properties which accumulate statistics instead of storing the last value set.
+
+		conn.request_rate += 1;            // Ewma:      feeds events; reads give events per second.
+		conn.peak_queue    = queue_size;   // HighWater: reads give the largest value set.
+		conn.p99_latency   = latency;      // Quantiles: feeds a sample; reads give the 99th percentile.
+
+	Each property's accumulator lives in the actual struct, so no side objects or locks are needed.
+		high_water and quantile_sketch are lock-free and may be fed from any thread.
+		ewma_rate is not thread-safe; it should be fed by one thread at a time.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Ewma(NAME, VARIABLE)              -- Rate of events per second, exponentially weighted.
+		HighWater(TYPE, NAME, VARIABLE)   -- Greatest value set.
+		Quantiles(NAME, VARIABLE, Q)      -- Estimated quantile Q (between 0 and 1) of the values set.
+
+		NAME     -- the name of this property accessor.
+		TYPE     -- the type of values.
+		VARIABLE -- a property_access::ewma_rate, high_water<TYPE> or quantile_sketch<> in ACTUAL_STRUCT.
+
+		Setting an Ewma property, or adding to it, records that many events.
+		Ewma and Quantiles properties have the type double.
+
+		e.g:
+
+			struct Connection
+			{
+				struct Stats
+				{
+					property_access::ewma_rate          requests{std::chrono::seconds(10)};
+					property_access::high_water<size_t> queue;
+					property_access::quantile_sketch<>  latency;
+				};
+
+				PropertyAccessors(Stats,
+					Ewma     (request_rate, requests),
+					HighWater(size_t, peak_queue, queue),
+					Quantiles(p99_latency, latency, 0.99)
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Ewma(NAME, VARIABLE) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		double get() const {return (VARIABLE).rate();}  void set(double events) {(VARIABLE).add(events);} \
+		template<typename F> void modify(F f) {double events = 0; f(events); (VARIABLE).add(events);}  };
+	#define EDB_PropertyAccessors_Union_Ewma(NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Ewma(NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+	#define EDB_PropertyAccessors_Setup_HighWater(TYPE, NAME, VARIABLE) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (VARIABLE).get();}  void set(const TYPE &value) {(VARIABLE).record(value);}  };
+	#define EDB_PropertyAccessors_Union_HighWater(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_HighWater(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+	#define EDB_PropertyAccessors_Setup_Quantiles(NAME, VARIABLE, Q) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		double get() const {return (VARIABLE).quantile(Q);}  void set(double value) {(VARIABLE).record(value);}  };
+	#define EDB_PropertyAccessors_Union_Quantiles(NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Quantiles(NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	/*
+		An exponentially weighted rate of events per second.  Decay is applied lazily,
+			when events are added or the rate is read, so an idle rate costs nothing.
+	*/
+	class ewma_rate
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+		explicit ewma_rate(clock::duration half_life)
+			: _decay(std::log(2.0) / std::chrono::duration<double>(half_life).count()) {}
+
+		void add(double events, clock::time_point now = clock::now())
+		{
+			_rate = _decayed(now) + events * _decay;
+			_last = now;
+		}
+
+		double rate(clock::time_point now = clock::now()) const    {return _decayed(now);}
+
+	private:
+		double _decayed(clock::time_point now) const
+		{
+			double elapsed = std::chrono::duration<double>(now - _last).count();
+			return elapsed > 0 ? _rate * std::exp(-_decay * elapsed) : _rate;
+		}
+
+		double            _decay;
+		double            _rate = 0;
+		clock::time_point _last = clock::now();
+	};
+
+
+	/*
+		The greatest value recorded, maintained with an atomic compare-and-swap.
+	*/
+	template<typename T>
+	class high_water
+	{
+	public:
+		high_water() noexcept                 : _value(std::numeric_limits<T>::lowest()) {}
+		explicit high_water(T initial) noexcept    : _value(initial) {}
+
+		T get() const noexcept    {return _value.load(std::memory_order_relaxed);}
+
+		void record(T value) noexcept
+		{
+			T current = _value.load(std::memory_order_relaxed);
+			while (current < value && !_value.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+		}
+
+		void reset(T value = std::numeric_limits<T>::lowest()) noexcept    {_value.store(value, std::memory_order_relaxed);}
+
+	private:
+		std::atomic<T> _value;
+	};
+
+
+	/*
+		A fixed-memory sketch of a distribution of non-negative values, for estimating quantiles.
+			Values are counted in logarithmically sized buckets, so estimates have a bounded
+			relative error (by default 2%) for values from min_value up to min_value * gamma^(Buckets - 2).
+			Smaller values are counted as zero and larger values in the last bucket.
+			Counts are relaxed atomics, so recording is lock-free.  Sketches with equal parameters can be merged.
+	*/
+	template<std::size_t Buckets = 1024>
+	class quantile_sketch
+	{
+	public:
+		explicit quantile_sketch(double relative_error = 0.02, double min_value = 1e-6)
+			: _gamma((1 + relative_error) / (1 - relative_error)), _log_gamma(std::log(_gamma)), _min(min_value) {}
+
+		quantile_sketch(const quantile_sketch&)            = delete;
+		quantile_sketch &operator=(const quantile_sketch&) = delete;
+
+		void record(double value) noexcept
+		{
+			_counts[_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+			_total.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		std::uint64_t count() const noexcept    {return _total.load(std::memory_order_relaxed);}
+
+		// Estimate the value at quantile q, between 0 and 1.  Returns NaN if nothing was recorded.
+		double quantile(double q) const noexcept
+		{
+			std::uint64_t total = count();
+			if (!total) return std::numeric_limits<double>::quiet_NaN();
+			auto rank = std::uint64_t(q * double(total - 1));
+			std::uint64_t seen = 0;
+			for (std::size_t i = 0; i < Buckets; ++i)
+			{
+				seen += _counts[i].load(std::memory_order_relaxed);
+				if (seen > rank) return _value(i);
+			}
+			return _value(Buckets - 1);
+		}
+
+		// Add the counts of another sketch with the same parameters.
+		void merge(const quantile_sketch &other) noexcept
+		{
+			for (std::size_t i = 0; i < Buckets; ++i) _counts[i].fetch_add(other._counts[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			_total.fetch_add(other.count(), std::memory_order_relaxed);
+		}
+
+		void reset() noexcept
+		{
+			for (auto &c : _counts) c.store(0, std::memory_order_relaxed);
+			_total.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		/*
+			Bucket 0 holds values below min_value, and bucket 1 holds min_value itself.
+				Each bucket i > 1 holds values in (min_value * gamma^(i-2), min_value * gamma^(i-1)],
+				except that the last bucket also holds all larger values.
+		*/
+		std::size_t _bucket(double value) const noexcept
+		{
+			if (!(value >= _min)) return 0;
+			double i = std::ceil(std::log(value / _min) / _log_gamma) + 1;
+			return i >= double(Buckets - 1) ? Buckets - 1 : std::size_t(i);
+		}
+
+		// A representative value for a bucket, within the relative error of every value in it.
+		double _value(std::size_t i) const noexcept
+		{
+			if (i == 0) return 0;
+			return _min * std::pow(_gamma, double(i) - 1) * 2 / (_gamma + 1);
+		}
+
+		double                     _gamma, _log_gamma, _min;
+		std::atomic<std::uint64_t> _counts[Buckets] = {};
+		std::atomic<std::uint64_t> _total = 0;
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_STATISTICS_H
@@ -0,0 +1,268 @@
+#ifndef EDB_PROPERTY_ACCESS_WAL_H
+#define EDB_PROPERTY_ACCESS_WAL_H
+
+
+/*
+	This header implements durable property writes to memory-mapped files, using a write-ahead log.  POSIX only.
+
+		property_access::write_ahead_log store("accounts.dat", "accounts.wal", count * sizeof(Account));
+		auto accounts = static_cast<Account*>(store.data());      // replayed from the log on open.
+
+		Ledger ledger = {{&accounts[7], &store}};
+		ledger.balance = 500;   // written to the mapping and appended to the log.
+		store.commit();         // returns once the write is durable.
+		store.checkpoint();     // occasionally: copies committed writes into the data file.
+
+	The data file is mapped privately (copy-on-write), so sets change only this process's view of it,
+		and the kernel never writes them back.  Each set through a Logged property also appends a record
+		of (offset, new bytes) to an in-memory buffer.  commit() writes pending records to the log and makes
+		them durable with fdatasync.  Concurrent commits are grouped: one thread writes and syncs everyone's
+		records while the others wait.  checkpoint() copies the committed records from the log into the data
+		file, syncs it and empties the log.
+
+	So after a crash, the data file holds exactly the writes of the last checkpoint, and replaying the log
+		on open restores the writes committed since.  Writes that were not committed are lost.
+		Records carry a checksum, and replay stops at the first incomplete record.
+		Written pages of the mapping stay private copies, in memory, until the log is closed.
+*/
+
+
+#include "../property_accessor.h"
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <condition_variable>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+#if !defined(PROPERTY_ACCESS_NO_MACROS)
+
+	/*
+		Logged(TYPE, NAME, VARIABLE, WAL)  -- Read-write value property whose sets are logged.
+
+		TYPE     -- a trivially copyable type.
+		NAME     -- the name of this property accessor.
+		VARIABLE -- an lvalue expression for the value, within WAL's mapping.
+		WAL      -- an expression giving the property_access::write_ahead_log.
+
+		e.g:
+
+			struct Ledger
+			{
+				struct Ref {Account *account; property_access::write_ahead_log *log;};
+
+				PropertyAccessors(Ref,
+					Logged(long, balance, account->balance, *log)
+				);
+			};
+	*/
+	#define EDB_PropertyAccessors_Setup_Logged(TYPE, NAME, VARIABLE, WAL) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME) \
+		TYPE get() const {return (VARIABLE);}  void set(const TYPE &value) {(VARIABLE) = value; (WAL).append(std::addressof(VARIABLE), sizeof(TYPE));}  };
+	#define EDB_PropertyAccessors_Union_Logged(TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
+	#define EDB_PropertyAccessors_Field_Logged(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+
+#endif //!defined(PROPERTY_ACCESS_NO_MACROS)
+
+
+namespace property_access
+{
+	/*
+		A memory-mapped data file with a write-ahead log of changes to it.
+	*/
+	class write_ahead_log
+	{
+	public:
+		// The header of each log record, followed by size bytes of data.
+		struct record_header
+		{
+			std::uint64_t offset;
+			std::uint32_t size;
+			std::uint32_t checksum;
+		};
+
+		// Open or create the data file with at least size bytes, and recover it from the log.
+		write_ahead_log(const char *data_path, const char *log_path, std::size_t size)
+		{
+			_data_fd = ::open(data_path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+			_log_fd  = ::open(log_path,  O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+			struct stat st;
+			if (_data_fd < 0 || _log_fd < 0 || ::fstat(_data_fd, &st) != 0) return;
+			if (std::size_t(st.st_size) < size && ::ftruncate(_data_fd, off_t(size)) != 0) return;
+			_size = std::max(size, std::size_t(st.st_size));
+
+			void *map = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, _data_fd, 0);
+			if (map == MAP_FAILED) return;
+			_data = static_cast<unsigned char*>(map);
+			_recover();
+		}
+
+		~write_ahead_log()
+		{
+			if (_data) {commit(); ::munmap(_data, _size);}
+			if (_data_fd >= 0) ::close(_data_fd);
+			if (_log_fd  >= 0) ::close(_log_fd);
+		}
+
+		write_ahead_log(const write_ahead_log&)            = delete;
+		write_ahead_log &operator=(const write_ahead_log&) = delete;
+
+		bool        is_open() const    {return _data != nullptr;}
+		void       *data() const       {return _data;}
+		std::size_t size() const       {return _size;}
+
+		// Log the current contents of a range within the mapping.  Ranges outside it are ignored.
+		void append(const void *address, std::size_t size)
+		{
+			auto p = static_cast<const unsigned char*>(address);
+			if (!_data || p < _data || p + size > _data + _size) return;
+
+			record_header h = {std::uint64_t(p - _data), std::uint32_t(size), 0};
+			std::lock_guard<std::mutex> lock(_mutex);
+			h.checksum = _checksum(h, p);
+			std::size_t at = _pending.size();
+			_pending.resize(at + sizeof(h) + size);
+			std::memcpy(&_pending[at], &h, sizeof(h));
+			std::memcpy(&_pending[at + sizeof(h)], p, size);
+			++_appended;
+		}
+
+		/*
+			Make all records appended so far durable.  Returns false on an I/O error.
+				If another thread is already syncing, wait for it, then sync whatever remains as a group.
+		*/
+		bool commit()
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			std::uint64_t target = _appended;
+			while (_durable < target && _ok)
+			{
+				if (_syncing) {_synced.wait(lock); continue;}
+
+				// Lead a group commit of all pending records.
+				_syncing = true;
+				std::uint64_t group = _appended;
+				_writing.swap(_pending);
+				lock.unlock();
+
+				bool ok = _write_all(_writing.data(), _writing.size()) && _sync(_log_fd);
+				_writing.clear();
+
+				lock.lock();
+				_syncing = false;
+				_ok = _ok && ok;
+				if (ok) _durable = group;
+				_synced.notify_all();
+			}
+			return _ok;
+		}
+
+		/*
+			Copy committed records into the data file and sync it, then empty the log.
+				Records not yet committed stay pending, and are written to the emptied log by the next commit.
+		*/
+		bool checkpoint()
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (_syncing) _synced.wait(lock);
+			_ok = _ok && _replay([this](const record_header &h, const unsigned char *bytes) {return _pwrite_all(bytes, h.size, h.offset);})
+				&& _sync(_data_fd) && ::ftruncate(_log_fd, 0) == 0 && _sync(_log_fd);
+			return _ok;
+		}
+
+	private:
+		static std::uint32_t _checksum(const record_header &h, const unsigned char *bytes)
+		{
+			// FNV-1a over the offset, size and data.
+			std::uint32_t c = 2166136261u;
+			auto mix = [&c](const unsigned char *p, std::size_t n) {while (n--) c = (c ^ *p++) * 16777619u;};
+			mix(reinterpret_cast<const unsigned char*>(&h.offset), sizeof(h.offset));
+			mix(reinterpret_cast<const unsigned char*>(&h.size),   sizeof(h.size));
+			mix(bytes, h.size);
+			return c;
+		}
+
+		static bool _sync(int fd)
+		{
+		#if defined(__APPLE__)
+			return ::fsync(fd) == 0;
+		#else
+			return ::fdatasync(fd) == 0;
+		#endif
+		}
+
+		bool _write_all(const unsigned char *p, std::size_t n)
+		{
+			while (n)
+			{
+				ssize_t w = ::write(_log_fd, p, n);
+				if (w <= 0) return false;
+				p += w; n -= std::size_t(w);
+			}
+			return true;
+		}
+
+		bool _pwrite_all(const unsigned char *p, std::size_t n, std::uint64_t offset)
+		{
+			while (n)
+			{
+				ssize_t w = ::pwrite(_data_fd, p, n, off_t(offset));
+				if (w <= 0) return false;
+				p += w; n -= std::size_t(w); offset += std::uint64_t(w);
+			}
+			return true;
+		}
+
+		/*
+			Call apply(header, bytes) for each complete record in the log, in order.
+				Returns false if reading fails or apply returns false.
+		*/
+		template<typename F>
+		bool _replay(F apply)
+		{
+			std::vector<unsigned char> log;
+			unsigned char chunk[1 << 16];
+			ssize_t n;
+			while ((n = ::pread(_log_fd, chunk, sizeof(chunk), off_t(log.size()))) > 0) log.insert(log.end(), chunk, chunk + n);
+			if (n < 0) return false;
+
+			for (std::size_t pos = 0; pos + sizeof(record_header) <= log.size();)
+			{
+				record_header h;
+				std::memcpy(&h, &log[pos], sizeof(h));
+				const unsigned char *bytes = &log[pos + sizeof(h)];
+				if (log.size() - pos - sizeof(h) < h.size || h.offset + h.size > _size || _checksum(h, bytes) != h.checksum) break;
+				if (!apply(h, bytes)) return false;
+				pos += sizeof(h) + h.size;
+			}
+			return true;
+		}
+
+		// Apply committed records from the log to the mapping, then checkpoint them into the data file.
+		void _recover()
+		{
+			struct stat st;
+			_replay([this](const record_header &h, const unsigned char *bytes) {std::memcpy(_data + h.offset, bytes, h.size); return true;});
+			if (::fstat(_log_fd, &st) == 0 && st.st_size > 0) checkpoint();
+		}
+
+		unsigned char *_data    = nullptr;
+		std::size_t    _size    = 0;
+		int            _data_fd = -1, _log_fd = -1;
+
+		std::mutex                 _mutex;
+		std::condition_variable    _synced;
+		std::vector<unsigned char> _pending, _writing;
+		std::uint64_t              _appended = 0, _durable = 0;
+		bool                       _syncing = false, _ok = true;
+	};
+}
+
+
+#endif //EDB_PROPERTY_ACCESS_WAL_H
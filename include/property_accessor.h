@@ -18,6 +18,10 @@
 */
 
 
+#include <tuple>
+#include <memory>
+#include <cstddef>
+#include <cstring>
 #include <utility>
 #include <type_traits>
 
@@ -75,10 +79,14 @@
 				GetSet (int, x_times_2,                          object->x*2,           int x2,  object->x = x2/2),
 				Custom (     x_times_3,  int get() const {return object->x*3;} void set(int x3) {object->x = x3/3;})
 			);
+
+		Blocks declared with this macro support reflection; see for_each_property.
 	*/
 	#define PropertyAccessors(ACTUAL_STRUCT, ...) \
 		\
 		struct _properties {using _property_actual_t = ACTUAL_STRUCT;  EDB_PP_MAP(EDB_PropertyAccessors_Setup, __VA_ARGS__) };\
+		auto _property_fields()       {return std::tuple_cat(std::tuple<>() EDB_PP_MAP(EDB_PropertyAccessors_Field, __VA_ARGS__));} \
+		auto _property_fields() const {return std::tuple_cat(std::tuple<>() EDB_PP_MAP(EDB_PropertyAccessors_Field, __VA_ARGS__));} \
 		union {      _properties::_property_actual_t _property_actual; EDB_PP_MAP(EDB_PropertyAccessors_Union, __VA_ARGS__) }
 
 
@@ -121,12 +129,14 @@
 	// implementation details of the PropertyAccessors macro.
 	#define EDB_PropertyAccessors_Setup(CALL) EDB_PropertyAccessors_Setup_ ## CALL
 	#define EDB_PropertyAccessors_Union(CALL) EDB_PropertyAccessors_Union_ ## CALL
+	#define EDB_PropertyAccessors_Field(CALL) EDB_PropertyAccessors_Field_ ## CALL
+	#define EDB_PropertyAccessors_Name(NAME)  static constexpr const char *_property_name() {return #NAME;}
 
 	#define EDB_PropertyAccessors_Setup_UnionMember(...)
-	#define EDB_PropertyAccessors_Setup_Proxy(  TYPE, NAME, REF_EXPR)                      struct _gs_ ## NAME : _property_actual_t {  TYPE& get() const {return (REF_EXPR);}  };
-	#define EDB_PropertyAccessors_Setup_GetOnly(TYPE, NAME, GET_EXPR)                      struct _gs_ ## NAME : _property_actual_t {  TYPE  get() const {return (GET_EXPR);}  };
-	#define EDB_PropertyAccessors_Setup_GetSet( TYPE, NAME, GET_EXPR, SET_PARAM, SET_EXPR) struct _gs_ ## NAME : _property_actual_t {  TYPE  get() const {return (GET_EXPR);}  void set(SET_PARAM) {(SET_EXPR);}  };
-	#define EDB_PropertyAccessors_Setup_Custom(NAME, ...)                                  struct _gs_ ## NAME : _property_actual_t {__VA_ARGS__};
+	#define EDB_PropertyAccessors_Setup_Proxy(  TYPE, NAME, REF_EXPR)                      struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME)  TYPE& get() const {return (REF_EXPR);}  };
+	#define EDB_PropertyAccessors_Setup_GetOnly(TYPE, NAME, GET_EXPR)                      struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME)  TYPE  get() const {return (GET_EXPR);}  };
+	#define EDB_PropertyAccessors_Setup_GetSet( TYPE, NAME, GET_EXPR, SET_PARAM, SET_EXPR) struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME)  TYPE  get() const {return (GET_EXPR);}  void set(SET_PARAM) {(SET_EXPR);}  };
+	#define EDB_PropertyAccessors_Setup_Custom(NAME, ...)                                  struct _gs_ ## NAME : _property_actual_t {  EDB_PropertyAccessors_Name(NAME)  __VA_ARGS__};
 
 	#define EDB_PropertyAccessors_Union_UnionMember(...) __VA_ARGS__
 	#define EDB_PropertyAccessors_Union_Proxy(  TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
@@ -134,6 +144,12 @@
 	#define EDB_PropertyAccessors_Union_GetSet( TYPE, NAME, ...) property_access::property<_properties::_gs_ ## NAME> NAME;
 	#define EDB_PropertyAccessors_Union_Custom(NAME, ...)        property_access::property<_properties::_gs_ ## NAME> NAME;
 
+	#define EDB_PropertyAccessors_Field_UnionMember(...)
+	#define EDB_PropertyAccessors_Field_Proxy(  TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+	#define EDB_PropertyAccessors_Field_GetOnly(TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+	#define EDB_PropertyAccessors_Field_GetSet( TYPE, NAME, ...) , std::make_tuple(std::addressof(NAME))
+	#define EDB_PropertyAccessors_Field_Custom(NAME, ...)        , std::make_tuple(std::addressof(NAME))
+
 	// Implementation details of the PropertyAccess_Members macro.
 	#define EDB_PropertyMembers_Variable(NAME) \
 		property_access::member<GetSet_t, &_property_class_t::NAME> NAME;
@@ -172,6 +188,44 @@ namespace property_access
 		template<typename GetSet_t, typename Y>
 		static constexpr bool has_setter = has_setter_impl<GetSet_t, Y>::value;
 
+		// Detects a modify(f) method, which applies a function to a value property's value in place.
+		struct modify_probe {template<typename T> void operator()(T&) const {}};
+
+		template<typename GetSet_t, typename = void> struct has_modifier_impl : public std::bool_constant<false> {};
+		template<typename GetSet_t>                  struct has_modifier_impl<GetSet_t, std::void_t<decltype(std::declval<GetSet_t&>().modify(modify_probe{}))>> : public std::bool_constant<true> {};
+
+		template<typename GetSet_t>
+		static constexpr bool has_modifier = has_modifier_impl<GetSet_t>::value;
+
+		// Detects equals(y) and hash() methods, which compare and hash a property's value in place.
+		template<typename GetSet_t, typename Y, typename = void> struct has_equals_impl : public std::bool_constant<false> {};
+		template<typename GetSet_t, typename Y>                  struct has_equals_impl<GetSet_t, Y, std::void_t<decltype(bool(std::declval<GetSet_t&>().equals(std::declval<Y>())))>> : public std::bool_constant<true> {};
+		template<typename GetSet_t, typename = void>             struct has_hash_impl : public std::bool_constant<false> {};
+		template<typename GetSet_t>                              struct has_hash_impl<GetSet_t, std::void_t<decltype(std::size_t(std::declval<GetSet_t&>().hash()))>> : public std::bool_constant<true> {};
+
+		template<typename GetSet_t, typename Y>
+		static constexpr bool has_equals = has_equals_impl<GetSet_t, Y>::value;
+		template<typename GetSet_t>
+		static constexpr bool has_hash = has_hash_impl<GetSet_t>::value;
+
+		// Detects whether a property's value can be compared with a value being assigned to it.
+		template<typename T, typename Y, typename = void> struct is_equality_comparable_impl : public std::bool_constant<false> {};
+		template<typename T, typename Y>                  struct is_equality_comparable_impl<T, Y, std::void_t<decltype(bool(std::declval<const T&>() == std::declval<const Y&>()))>> : public std::bool_constant<true> {};
+
+		template<typename T, typename Y>
+		static constexpr bool is_equality_comparable = is_equality_comparable_impl<std::decay_t<T>, std::decay_t<Y>>::value;
+
+		/*
+			Whether a value being assigned is the same as the current value.  Floats and doubles are compared
+				bitwise, so that assigning -0.0 over 0.0 isn't skipped and a NaN compares equal to itself.
+		*/
+		template<typename T, typename Y>
+		bool same_value(const T &current, const Y &y)
+		{
+			if constexpr (std::is_same_v<T, Y> && (std::is_same_v<T, float> || std::is_same_v<T, double>)) return std::memcmp(&current, &y, sizeof(T)) == 0;
+			else return bool(current == y);
+		}
+
 
 		/*
 			This template detects if a type is a property accessor by checking for the presence of a member named _property_accessor_tag.
@@ -217,8 +271,15 @@ namespace property_access
 
 		EDB_tmp_DetectablePropertyOption(pointer_emulation)
 		EDB_tmp_DetectablePropertyOption(implicit_conversion)
+		EDB_tmp_DetectablePropertyOption(skip_unchanged)
+		EDB_tmp_DetectablePropertyOption(deferred_modify)
 
 #undef EDB_tmp_DetectPropertyOption
+
+
+		// Detects the name of a getter/setter declared with the PropertyAccessors macro.
+		template<typename GetSet_t, typename = void> struct getset_name                                                          {static constexpr const char *value = nullptr;};
+		template<typename GetSet_t>                  struct getset_name<GetSet_t, std::void_t<decltype(GetSet_t::_property_name())>> {static constexpr const char *value = GetSet_t::_property_name();};
 	}
 
 
@@ -238,19 +299,14 @@ namespace property_access
 				It may be placed in an anonymous union to facilitate member variable sub-properties.
 		*/
 		GetSet_t _property_getset;
-	};
 
-	/*
-		Default specializations for class, struct and union type property accessors.
-			In order to facilitate access to member variables, we add pointer-like semantics.
-	*/
-	template<typename T, typename GetSet_t>
-	struct members<T, GetSet_t, std::enable_if_t<(std::is_class_v<T> || std::is_union_v<T>)>>
-	{
-		GetSet_t _property_getset;
-
-		// If T is a class/struct/union type.
-		static constexpr bool _property_option_pointer_emulation = true;
+		/*
+			By default, class, struct and union type property accessors have pointer-like semantics
+				in order to facilitate access to member variables.
+				This is decided here rather than in a partial specialization so that partial specializations
+				for class templates (such as members<std::atomic<T>, GetSet_t>) are not ambiguous.
+		*/
+		static constexpr bool _property_option_pointer_emulation = (std::is_class_v<T> || std::is_union_v<T>);
 	};
 
 	
@@ -263,6 +319,18 @@ namespace property_access
 #define EDB_tmp_FwdPrefOp_(OP, CONST) decltype(auto) operator OP ()    CONST {return OP this->_property_get();}
 #define EDB_tmp_FwdPostOp_(OP, CONST) decltype(auto) operator OP (int) CONST {return this->_property_get() OP;}
 
+		/*
+			Equality comparisons use the getter/setter's equals(y) method if it has one, which may compare
+				a large value in place rather than copying it.  equals(other_getset) is used to compare
+				two property accessors of the same type.
+		*/
+#define EDB_tmp_FwdEqOp(OP, NOT)      EDB_tmp_FwdEqOp_(OP, NOT, const) EDB_tmp_FwdEqOp_(OP, NOT, )
+#define EDB_tmp_FwdEqOp_(OP, NOT, CONST) template<typename Y, std::enable_if_t<!detail::is_property_accessor_v<Y>, bool> = true> \
+    decltype(auto) operator OP (Y &&y) CONST {if constexpr (detail::has_equals<const GetSet_t, Y&&>) return NOT this->_property_getset.equals(std::forward<Y>(y)); \
+    else return this->_property_get() OP std::forward<Y>(y);} \
+    template<typename G = GetSet_t, std::enable_if_t<detail::has_equals<const G, const G&>, bool> = true> \
+    bool operator OP (const property &other) CONST {return NOT this->_property_getset.equals(other._property_getset);}
+
 
 	/*
 		Implementation details shared by all property accessors.
@@ -295,16 +363,28 @@ namespace property_access
 		static struct {}      _property_accessor_tag;
 		static constexpr bool _property_option_pointer_emulation   = detail::option_pointer_emulation  <_property_members_t>::value;
 		static constexpr bool _property_option_implicit_conversion = detail::option_implicit_conversion<_property_members_t>::value;
+		static constexpr bool _property_option_skip_unchanged      = detail::option_skip_unchanged     <_property_members_t>::value || detail::option_skip_unchanged<GetSet_t>::value;
 
 		// Get methods.
 		decltype(std::declval<const GetSet_t>().get()) _property_get() const    {return this->_property_getset.get();}
 		decltype(std::declval<      GetSet_t>().get()) _property_get()          {return this->_property_getset.get();}
 
-		// Set methods, if applicable.
+		/*
+			Set methods, if applicable.
+				If _property_option_skip_unchanged is enabled, assigning a value equal to the current one
+				does nothing, so it doesn't dirty the value's cache line or run the setter's side effects.
+				It may be enabled for every property in a block by declaring
+				`static constexpr bool _property_option_skip_unchanged = true;` in the actual struct,
+				or for one property by declaring it in a Custom getter/setter.
+				Values are compared with the getter/setter's equals(y) method if it has one.
+				Getter/setters declaring _property_option_deferred_modify may be set from a thread that
+				mustn't read the value, so assignments to them are never skipped; compound assignments
+				through modify(f) still compare where f runs.
+		*/
 		template<typename Y, std::enable_if_t<_property_by_proxy || detail::has_setter<const GetSet_t,Y>, bool> = true>
-		decltype(auto) _property_set(Y &&y) const    {if constexpr (_property_by_proxy) return this->_property_get() = std::forward<Y>(y); else return this->_property_getset.set(std::forward<Y>(y));}
+		decltype(auto) _property_set(Y &&y) const    {if constexpr (_property_skips<const GetSet_t, Y>) {if (!this->_property_unchanged(y)) this->_property_set_always(std::forward<Y>(y));} else return this->_property_set_always(std::forward<Y>(y));}
 		template<typename Y, std::enable_if_t<_property_by_proxy || detail::has_setter<      GetSet_t,Y>, bool> = true>
-		decltype(auto) _property_set(Y &&y)          {if constexpr (_property_by_proxy) return this->_property_get() = std::forward<Y>(y); else return this->_property_getset.set(std::forward<Y>(y));}
+		decltype(auto) _property_set(Y &&y)          {if constexpr (_property_skips<      GetSet_t, Y>) {if (!this->_property_unchanged(y)) this->_property_set_always(std::forward<Y>(y));} else return this->_property_set_always(std::forward<Y>(y));}
 
 		/*
 			Support implicit conversion to the getter's return type.
@@ -352,7 +432,7 @@ namespace property_access
 				In the case of value property accessors, these are assumed not to mutate the value.
 		*/
 		EDB_tmp_FwdBiOp(>)    EDB_tmp_FwdBiOp(>=)   EDB_tmp_FwdBiOp(<)    EDB_tmp_FwdBiOp(<=)  
-		EDB_tmp_FwdBiOp(==)   EDB_tmp_FwdBiOp(!=)  
+		EDB_tmp_FwdEqOp(==, ) EDB_tmp_FwdEqOp(!=, !)
 		EDB_tmp_FwdPrefOp(+)  EDB_tmp_FwdPrefOp(-)  EDB_tmp_FwdPrefOp(!)  EDB_tmp_FwdPrefOp(~) 
 		EDB_tmp_FwdBiOp(+)    EDB_tmp_FwdBiOp(-)    EDB_tmp_FwdBiOp(*)    EDB_tmp_FwdBiOp(/)   
 		EDB_tmp_FwdBiOp(%)    EDB_tmp_FwdBiOp(<<)   EDB_tmp_FwdBiOp(>>)  
@@ -399,10 +479,23 @@ namespace property_access
 		template<typename Y> decltype(auto) operator=(Y &&y)       {return (this->_property_set(std::forward<Y>(y)), *this);}
 
 
-		// Boilerplate for applying assigment operators and increments/decrements to a value property accessor
+		/*
+			Boilerplate for applying assigment operators and increments/decrements to a value property accessor.
+				If the getter/setter has a modify(f) method, the operation is passed to it as a function
+				modifying the value in place.  This function holds a copy of the operand, so it may be
+				invoked later or on another thread.  Otherwise, the value is copied, modified and set.
+				Getter/setters declaring _property_option_deferred_modify don't support postfix increments,
+				since the value they would return may not be the one that is replaced.
+				With _property_option_skip_unchanged, reference accessors are also copied, modified and set,
+				and compound assignments passed to modify(f) only store the result if it differs.
+				modify(f) itself is still called, since it may defer f or have other effects.
+		*/
 #define EDB_tmp_CompoundAssignOp(OP)           EDB_tmp_CompoundAssignOp_  (OP, const) EDB_tmp_CompoundAssignOp_  (OP, )
 #define EDB_tmp_CompoundAssignOp_(OP, CONST)   template<typename Y, std::enable_if_t<!detail::is_property_accessor_v<Y>, bool> = true> decltype(auto) operator OP (Y &&y) CONST \
-			{if constexpr (_property_by_proxy) return this->_property_get() OP std::forward<Y>(y); \
+			{if constexpr (_property_by_proxy && _property_skips<CONST GetSet_t, _property_get_const_t>) {auto x = this->_property_get(); x OP std::forward<Y>(y); this->_property_set(std::move(x)); return this->_property_get();} \
+			else if constexpr (_property_by_proxy) return this->_property_get() OP std::forward<Y>(y); \
+			else if constexpr (detail::has_modifier<CONST GetSet_t>) return (this->_property_getset.modify([y = std::decay_t<Y>(std::forward<Y>(y))](auto &x) \
+				{if constexpr (_property_skips_in_place<std::decay_t<decltype(x)>>) {auto v = x; v OP y; if (!detail::same_value(x, v)) x = std::move(v);} else x OP y;}), *this); \
 			else {auto x=this->_property_get(); return (x OP std::forward<Y>(y), this->_property_set(x), *this);}}
 
 		// Compound assignment operators, where supported by the value.
@@ -413,14 +506,38 @@ namespace property_access
 		// Increment and decrement operators, where supported by the value.
 #define EDB_tmp_IncrPrefOp(OP)         EDB_tmp_IncrPrefOp_(OP, const) EDB_tmp_IncrPrefOp_(OP, )
 #define EDB_tmp_IncrPostOp(OP)         EDB_tmp_IncrPostOp_(OP, const) EDB_tmp_IncrPostOp_(OP, )
-#define EDB_tmp_IncrPrefOp_(OP, CONST) decltype(auto) operator OP ()    CONST {if constexpr (_property_by_proxy) return OP this->_property_get(); else {auto x = this->_property_get(); return (OP x, this->_property_set(x), *this);}}
-#define EDB_tmp_IncrPostOp_(OP, CONST) decltype(auto) operator OP (int) CONST {if constexpr (_property_by_proxy) return this->_property_get() OP; else {auto x = this->_property_get(), y = x; return (x OP, this->_property_set(x), y);}}
+#define EDB_tmp_IncrPrefOp_(OP, CONST) decltype(auto) operator OP ()    CONST {if constexpr (_property_by_proxy) return OP this->_property_get(); \
+			else if constexpr (detail::has_modifier<CONST GetSet_t>) return (this->_property_getset.modify([](auto &x) {OP x;}), *this); \
+			else {auto x = this->_property_get(); return (OP x, this->_property_set(x), *this);}}
+#define EDB_tmp_IncrPostOp_(OP, CONST) decltype(auto) operator OP (int) CONST {if constexpr (_property_by_proxy) return this->_property_get() OP; \
+			else if constexpr (detail::has_modifier<CONST GetSet_t>) {static_assert(!detail::option_deferred_modify<GetSet_t>::value, \
+				"Postfix increment and decrement can't return the replaced value when modify() may be deferred; use the prefix form."); \
+				auto y = this->_property_get(); this->_property_getset.modify([](auto &x) {x OP;}); return y;} \
+			else {auto x = this->_property_get(), y = x; x OP; this->_property_set(std::move(x)); return y;}}
 
 		EDB_tmp_IncrPrefOp(++) EDB_tmp_IncrPrefOp(--)
 		EDB_tmp_IncrPostOp(++) EDB_tmp_IncrPostOp(--)
 
 
 	private:
+		template<typename G, typename Y>
+		static constexpr bool _property_skips = _property_option_skip_unchanged && !detail::option_deferred_modify<GetSet_t>::value && (detail::has_equals<const G, const Y&> || detail::is_equality_comparable<_property_get_const_t, Y>);
+
+		template<typename T>
+		static constexpr bool _property_skips_in_place = _property_option_skip_unchanged && detail::is_equality_comparable<T, T>;
+
+		template<typename Y>
+		bool _property_unchanged(const Y &y) const
+		{
+			if constexpr (detail::has_equals<const GetSet_t, const Y&>) return this->_property_getset.equals(y);
+			else return detail::same_value(this->_property_get(), y);
+		}
+
+		template<typename Y>
+		decltype(auto) _property_set_always(Y &&y) const    {if constexpr (_property_by_proxy) return this->_property_get() = std::forward<Y>(y); else return this->_property_getset.set(std::forward<Y>(y));}
+		template<typename Y>
+		decltype(auto) _property_set_always(Y &&y)          {if constexpr (_property_by_proxy) return this->_property_get() = std::forward<Y>(y); else return this->_property_getset.set(std::forward<Y>(y));}
+
 		// Property accessors don't independently exist and shouldn't be copy-constructed or move-constructed.
 		property(const property &o);
 	};
@@ -458,6 +575,36 @@ namespace property_access
 	template<typename GetSet_t, auto PointerToMember>
 	using member = property<getset_member<GetSet_t, PointerToMember>>;
 
+
+	/*
+		Reflection over property blocks declared with the PropertyAccessors macro.
+			Other blocks may support reflection by defining a method _property_fields()
+			which returns a tuple of pointers to their property accessors.
+	*/
+	template<typename Block_t>
+	using property_fields_t = decltype(std::declval<Block_t&>()._property_fields());
+
+	template<typename Block_t>
+	static constexpr std::size_t property_count_v = std::tuple_size_v<property_fields_t<Block_t>>;
+
+	// Whether a type is a property block supporting reflection.
+	template<typename T, typename = void>
+	static constexpr bool is_property_block_v = false;
+
+	template<typename T>
+	static constexpr bool is_property_block_v<T, std::void_t<property_fields_t<T>>> = true;
+
+	// Get the name of a property accessor declared with the PropertyAccessors macro, or nullptr.
+	template<typename GetSet_t>
+	constexpr const char *property_name(const property<GetSet_t>&)    {return detail::getset_name<GetSet_t>::value;}
+
+	// Call f(name, accessor) for each property accessor in a block, in order of declaration.
+	template<typename Block_t, typename F>
+	void for_each_property(Block_t &block, F &&f)
+	{
+		std::apply([&f](auto*... p) {(f(property_name(*p), *p), ...);}, block._property_fields());
+	}
+
 	/*
 		When a property accessor is the right-hand operand to some operator, substitute the value.
 			This allows properties to be used with iostreams among many other applications.
@@ -486,6 +633,8 @@ namespace property_access
 
 #undef EDB_tmp_FwdBiOp_
 #undef EDB_tmp_FwdBiOp
+#undef EDB_tmp_FwdEqOp_
+#undef EDB_tmp_FwdEqOp
 #undef EDB_tmp_FwdPrefOp_
 #undef EDB_tmp_FwdPrefOp
 #undef EDB_tmp_FwdPostOp_
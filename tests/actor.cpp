@@ -0,0 +1,67 @@
+// Build and run: c++ -std=c++17 -pthread -Iinclude tests/actor.cpp -o actor_test && ./actor_test
+
+#include <property_access/actor.h>
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+
+// As in the header's example.
+struct Counter
+{
+	struct State {long count = 0; double level = 1; property_access::actor_queue<> queue{64};};
+
+	PropertyAccessors(State,
+		Actor(long,   total, count, queue),
+		Actor(double, gain,  level, queue)
+	);
+
+	Counter() : _property_actual() {}
+	~Counter() {_property_actual.~State();}
+};
+
+
+int main()
+{
+	Counter c;
+	auto &queue = c._property_actual.queue;
+
+	// On the owning thread, operations apply directly.
+	c.total = 5;
+	c.total += 2;
+	++c.total;
+	c.gain *= 2.0;
+	assert(c.total == 8 && c.gain == 2.0 && queue.drain() == 0);
+
+	// From other threads, operations are posted and applied by drain().
+	std::thread([&] {c.total = 100; c.gain *= 3.0;}).join();
+	assert(c.total == 8);
+	assert(queue.drain() == 2 && c.total == 100 && c.gain == 6.0);
+
+	// Concurrent compound assignments from several threads are not lost,
+	// even when they outnumber the queue's capacity and senders must wait.
+	const int threads = 4, increments = 20000;
+	std::vector<std::thread> senders;
+	for (int t = 0; t < threads; ++t) senders.emplace_back([&] {for (int i = 0; i < increments; ++i) c.total += 1;});
+	std::size_t applied = 0;
+	while (applied < std::size_t(threads * increments)) applied += queue.drain();
+	for (auto &t : senders) t.join();
+	assert(queue.drain() == 0 && c.total == 100 + threads * increments);
+
+	// Ownership can be handed to another thread.
+	std::thread owner([&]
+	{
+		queue.set_owner();
+		c.total = 1;
+		assert(c.total == 1);
+	});
+	owner.join();
+	c.total = 2;  // no longer the owner: posted.
+	assert(c.total == 1);
+	queue.set_owner();
+	assert(queue.drain() == 1 && c.total == 2);
+
+	return 0;
+}
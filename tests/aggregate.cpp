@@ -0,0 +1,131 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/aggregate.cpp -o aggregate_test && ./aggregate_test
+
+#include <property_access/aggregate.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+
+
+struct Unit
+{
+	struct State {int team; long score; double hp; std::string name; int id;};
+
+	PropertyAccessors(State,
+		GetOnly(int,         team,  team),
+		GetOnly(long,        score, score),
+		GetOnly(double,      hp,    hp),
+		GetOnly(std::string, name,  name),
+		GetOnly(int,         id,    id)
+	);
+
+	Unit() : _property_actual() {}
+	~Unit() {_property_actual.~State();}
+};
+
+
+int main()
+{
+	using namespace property_access;
+
+	const int n = 50000;
+	std::vector<Unit> units(n);
+	std::mt19937 rng(2);
+	for (int i = 0; i < n; ++i)
+	{
+		auto &a = units[i]._property_actual;
+		a.team  = int(rng() % 7) - 3;
+		a.score = rng() % 100;
+		a.hp    = (rng() % 1000) / 10.0;
+		a.name  = std::to_string(rng() % 20000);
+		a.id    = i;
+	}
+
+	// Few groups: grouped by hashing.
+	auto rows = group_by(units.data(), n, &Unit::team).aggregate(agg_sum(&Unit::score), agg_count(), agg_max(&Unit::hp), agg_min(&Unit::hp));
+	std::map<int, std::tuple<long, std::size_t, double, double>> expected;
+	for (auto &u : units)
+	{
+		auto &a = u._property_actual;
+		auto it = expected.find(a.team);
+		if (it == expected.end()) expected[a.team] = {a.score, 1, a.hp, a.hp};
+		else
+		{
+			auto &[score, count, high, low] = it->second;
+			score += a.score;
+			++count;
+			high = std::max(high, a.hp);
+			low  = std::min(low, a.hp);
+		}
+	}
+	assert(rows.size() == expected.size());
+	auto e = expected.begin();
+	for (auto &[team, score, count, high, low] : rows)
+	{
+		assert(team == e->first);
+		assert(std::tie(score, count, high, low) == e->second);
+		++e;
+	}
+
+	// Many groups: grouped by sorting.
+	auto rows2 = group_by(units.data(), n, &Unit::name).aggregate(agg_count(), agg_sum(&Unit::id));
+	std::map<std::string, std::pair<std::size_t, long>> expected2;
+	for (auto &u : units) {auto &p = expected2[u._property_actual.name]; ++p.first; p.second += u._property_actual.id;}
+	assert(rows2.size() == expected2.size());
+	std::size_t k = 0;
+	for (auto &[name, p] : expected2) {assert(rows2[k] == std::make_tuple(name, p.first, p.second)); ++k;}
+
+	assert(group_by(units.data(), 0, &Unit::team).aggregate(agg_count()).empty());
+
+	// min and max ignore NaNs wherever they appear, and give NaN only when every value is NaN.
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	double hps[][3] = {{nan, 2, 1}, {2, nan, 1}, {2, 1, nan}, {nan, nan, nan}};
+	for (auto &order : hps)
+	{
+		std::vector<Unit> group(3);
+		for (int i = 0; i < 3; ++i) group[i]._property_actual.hp = order[i];
+		auto rows3 = group_by(group.data(), 3, &Unit::team).aggregate(agg_min(&Unit::hp), agg_max(&Unit::hp), agg_sum(&Unit::hp));
+		assert(rows3.size() == 1);
+		auto &row = rows3[0];
+		if (&order == &hps[3]) assert(std::isnan(std::get<1>(row)) && std::isnan(std::get<2>(row)));
+		else assert(std::get<1>(row) == 1 && std::get<2>(row) == 2);
+		assert(std::isnan(std::get<3>(row)));
+	}
+
+	// NaN keys form one group, ordered last, whether grouped by hashing or by sorting.
+	for (int distinct : {3, 5000})
+	{
+		std::vector<Unit> keyed(10000);
+		for (int i = 0; i < 10000; ++i)
+		{
+			keyed[i]._property_actual.hp    = i % 7 == 0 ? nan : (i % 2 ? -1.0 : 1.0) * (i % distinct);
+			keyed[i]._property_actual.score = 1;
+		}
+		auto rows4 = group_by(keyed.data(), keyed.size(), &Unit::hp).aggregate(agg_count(), agg_sum(&Unit::score));
+		std::size_t nans = 0, total = 0;
+		for (std::size_t r = 0; r < rows4.size(); ++r)
+		{
+			double key = std::get<0>(rows4[r]);
+			if (std::isnan(key)) {assert(r == rows4.size() - 1); nans = std::get<1>(rows4[r]);}
+			else assert(r == 0 || std::get<0>(rows4[r - 1]) < key);
+			assert(std::get<1>(rows4[r]) == std::size_t(std::get<2>(rows4[r])));
+			total += std::get<1>(rows4[r]);
+		}
+		assert(nans == (10000 + 6) / 7 && total == 10000);
+		assert(std::isnan(std::get<0>(rows4.back())));
+	}
+
+	// The aggregate names don't collide with the standard algorithms.
+	{
+		using namespace std;
+		vector<double> values = {2, 1, 2};
+		assert(min(1, 2) == 1 && max(1, 2) == 2 && count(values.begin(), values.end(), 2.0) == 2);
+	}
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/checkpoint.cpp -o checkpoint_test && ./checkpoint_test
+
+#include <property_access/checkpoint.h>
+
+#include <cassert>
+#include <string>
+
+
+struct Player
+{
+	struct State {float x, y; int hp;};
+
+	PropertyAccessors(State,
+		GetSet (float, x,  x,  float v, x = v),
+		GetSet (int,   hp, hp, int v,   hp = v),
+		GetOnly(float, sum, x + y)
+	);
+};
+
+struct Named
+{
+	struct State
+	{
+		std::string name;
+		int         score;
+		double     *weight;
+		int         sets = 0;
+		int        *level;
+	};
+
+	PropertyAccessors(State,
+		GetOnly(std::string, name, name),
+		GetSet (int, score, score, int v, (++sets, score = v)),
+		Proxy  (double, weight, *weight),
+		Proxy  (int, level, *level)
+	);
+
+	Named() : _property_actual() {}
+	~Named() {_property_actual.~State();}
+};
+
+// As Named without the string: trivially copyable, but proxies still save what they refer to.
+struct Pointed
+{
+	struct State {int score; double *weight; int *level;};
+
+	PropertyAccessors(State,
+		GetSet(int, score, score, int v, score = v),
+		Proxy (double, weight, *weight),
+		Proxy (int, level, *level)
+	);
+};
+
+
+int main()
+{
+	property_access::checkpoint_arena arena(64);
+
+	// Trivially copyable actual structs are copied whole.
+	Player players[3] = {{{1, 2, 3}}, {{4, 5, 6}}, {{7, 8, 9}}};
+	auto cp = property_access::checkpoint(players, 3, arena);
+	players[0].x = 100;
+	players[2].hp = -1;
+	property_access::restore(players, cp);
+	assert(players[0].x == 1 && players[2].hp == 9 && players[1].sum == 9);
+
+	// Other blocks save settable properties: proxies directly, others through accessors.
+	int    levels[2]  = {3, 4};
+	double weights[2] = {};
+	Named named[2];
+	named[0]._property_actual.name = "a";
+	for (int i = 0; i < 2; ++i)
+	{
+		named[i]._property_actual.level  = &levels[i];
+		named[i]._property_actual.weight = &weights[i];
+		named[i].score  = 5 + i;
+		named[i].weight = 1.5 + i;
+	}
+	static_assert(property_access::detail::checkpoint_size_v<Named> == 32);
+
+	for (int frame = 0; frame < 10; ++frame) property_access::checkpoint(named, 2, arena);
+	auto cp2 = property_access::checkpoint(named, 2, arena);
+	for (auto &n : named) {n.score = 0; n.weight = 0; n.level = 0; n._property_actual.sets = 0;}
+	property_access::restore(named, cp2);
+	for (int i = 0; i < 2; ++i)
+	{
+		assert(named[i].score == 5 + i && named[i].weight == 1.5 + i && levels[i] == 3 + i);
+		assert(named[i]._property_actual.sets == 1);  // each setter runs once per restore.
+	}
+	assert(named[0].name == std::string("a"));
+
+	// Proxies behave the same whether or not the actual struct is trivially copyable.
+	static_assert(!property_access::detail::checkpoint_by_memcpy<Pointed>);
+	static_assert(property_access::detail::checkpoint_by_memcpy<Player>);
+	double pointed_weights[2] = {2.5, 3.5};
+	Pointed pointed[2] = {{{1, &pointed_weights[0], &levels[0]}}, {{2, &pointed_weights[1], &levels[1]}}};
+	auto cp3 = property_access::checkpoint(pointed, 2, arena);
+	for (auto &p : pointed) {p.score = 0; p.weight = 0; p.level = 0;}
+	property_access::restore(pointed, cp3);
+	for (int i = 0; i < 2; ++i) assert(pointed[i].score == 1 + i && pointed[i].weight == 2.5 + i && levels[i] == 3 + i);
+
+	arena.reset();
+	return 0;
+}
@@ -0,0 +1,75 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/diff.cpp -o diff_test && ./diff_test
+
+#include <property_access/diff.h>
+
+#include <cassert>
+#include <string>
+
+
+struct Player
+{
+	struct State {int hp; float x; std::string name; int *score;};
+
+	PropertyAccessors(State,
+		GetSet (int,         hp,    hp, int v,   hp = v),
+		GetSet (float,       x,     x,  float v, x = v),
+		GetOnly(std::string, name,  name),
+		Proxy  (int,         score, *score)
+	);
+
+	Player(int hp, float x, const char *name, int *score) : _property_actual{hp, x, name, score} {}
+	~Player() {_property_actual.~State();}
+};
+
+
+// A block whose values are held elsewhere.
+struct Size
+{
+	struct State {int *width, *height;};
+
+	PropertyAccessors(State,
+		Proxy(int, width,  *width),
+		Proxy(int, height, *height)
+	);
+};
+
+struct Window
+{
+	struct State {Size *size; int id;};
+
+	PropertyAccessors(State,
+		Proxy  (Size, size, *size),
+		GetOnly(int,  id,   id)
+	);
+};
+
+
+int main()
+{
+	int s1 = 10, s2 = 10;
+	Player a(100, 1.5f, "a", &s1), b(100, 1.5f, "a", &s2);
+	assert(property_access::diff(a, b).none());
+
+	// Bits are numbered in order of declaration.
+	b.hp = 90;
+	s2 = 11;
+	auto changed = property_access::diff(a, b);
+	assert(changed.count() == 2 && changed[0] && changed[3]);
+
+	b._property_actual.name = "b";
+	assert(property_access::diff(a, b)[2]);
+
+	// Floating point values are compared with ==.
+	Player c(100, 0.0f, "a", &s1), d(100, -0.0f, "a", &s1);
+	assert(property_access::diff(c, d).none());
+
+	// Nested blocks are compared by their values, not by the pointers they hold.
+	int w1 = 640, h1 = 480, w2 = 640, h2 = 480;
+	Size   z1 = {{&w1, &h1}}, z2 = {{&w2, &h2}};
+	Window x  = {{&z1, 7}},   y  = {{&z2, 7}};
+	assert(property_access::diff(x, y).none());
+	h2 = 400;
+	assert(property_access::diff(x, y) == property_access::property_mask<Window>(1));
+
+	return 0;
+}
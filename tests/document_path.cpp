@@ -0,0 +1,98 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/document_path.cpp -o document_path_test && ./document_path_test
+
+#include <property_access/document_path.h>
+
+#include <cassert>
+#include <map>
+#include <string>
+#include <vector>
+
+
+// A minimal DOM with the nlohmann::json-like interface document_node expects by default.
+static int created = 0;
+
+struct Node
+{
+	double                                   number = 0;
+	std::string                              text;
+	std::map<std::string, Node, std::less<>> members;
+	std::vector<Node>                        elements;
+
+	Node *find(std::string_view key)    {auto it = members.find(key); return it == members.end() ? nullptr : &it->second;}
+	Node *end()                         {return nullptr;}
+	std::size_t size() const            {return elements.size();}
+
+	Node &operator[](std::string_view key)    {++created; return members.emplace(std::string(key), Node()).first->second;}
+	Node &operator[](std::size_t index)       {if (index >= elements.size()) {++created; elements.resize(index + 1);} return elements[index];}
+
+	template<typename T>
+	T get() const
+	{
+		if constexpr (std::is_same_v<T, std::string>) return text;
+		else return T(number);
+	}
+
+	Node &operator=(double v)                {number = v; return *this;}
+	Node &operator=(const std::string &v)    {text = v; return *this;}
+};
+
+struct Document {Node root; std::uint64_t generation = 0;};
+
+struct Settings
+{
+	struct State {Document *doc; property_access::path_cache<Node> cached;};
+
+	PropertyAccessors(State,
+		JsonPath      (int,         volume, doc->root, "audio.volume"),
+		JsonPath      (std::string, user,   doc->root, "users[1].name"),
+		CachedJsonPath(double,      gain,   doc->root, "audio.mixer[2].gain", cached, doc->generation)
+	);
+};
+
+
+int main()
+{
+	using namespace property_access;
+
+	// Paths are compiled into member and index steps.
+	constexpr auto p = compile_path<path_length("a.b[3][4].c")>("a.b[3][4].c");
+	static_assert(path_length("a.b[3][4].c") == 5 && path_length("[0].x") == 2 && path_length("") == 0);
+	static_assert(!p.steps[0].is_index && p.steps[0].key == "a" && p.steps[2].is_index && p.steps[2].index == 3 && p.steps[4].key == "c");
+
+	Document doc;
+	Settings s = {{&doc, {}}};
+
+	// Missing nodes read as value-initialized values, without creating anything.
+	assert(s.volume == 0 && std::string(s.user).empty() && s.gain == 0.0);
+	assert(created == 0 && doc.root.members.empty());
+
+	// Setting creates the path, then reads convert the node.
+	s.volume = 7;
+	s.user   = std::string("ada");
+	assert(s.volume == 7 && std::string(s.user) == "ada");
+	assert(doc.root.members.at("users").elements.size() == 2);
+
+	// Reads of an existing path create nothing.
+	int before = created;
+	for (int i = 0; i < 10; ++i) assert(s.volume == 7);
+	assert(created == before);
+
+	// Cached paths reuse the resolved node until the generation changes.
+	s.gain = 0.5;
+	Node *node = &doc.root.members.at("audio").members.at("mixer").elements[2].members.at("gain");
+	assert(s.gain == 0.5);
+	node->number = 0.25;
+	assert(s.gain == 0.25);
+	doc.root.members.at("audio").members.at("mixer").elements.resize(100);  // moves the nodes.
+	++doc.generation;
+	assert(s.gain == 0.25);
+	s.gain += 1;
+	assert(doc.root.members.at("audio").members.at("mixer").elements[2].members.at("gain").number == 1.25);
+
+	// A cache is bypassed for a different root.
+	Document other;
+	s._property_actual.doc = &other;
+	assert(s.gain == 0.0);
+
+	return 0;
+}
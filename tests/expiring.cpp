@@ -0,0 +1,51 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/expiring.cpp -o expiring_test && ./expiring_test
+
+#include <property_access/expiring.h>
+
+#include <cassert>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+struct Player
+{
+	struct State {property_access::expiring<bool> cooling_down; property_access::expiring<int> boost;};
+
+	PropertyAccessors(State,
+		Expiring(bool, cooldown, cooling_down, false),
+		Expiring(int,  speed,    boost,        10)
+	);
+};
+
+int main()
+{
+	Player p{};
+	assert(!p.cooldown && p.speed == 10);
+
+	// Values revert to the default after their time-to-live.
+	p.cooldown = property_access::ttl(true, 50ms);
+	assert(p.cooldown);
+	std::this_thread::sleep_for(80ms);
+	assert(!p.cooldown);
+
+	// Compound assignments and increments keep the deadline.
+	p.speed = property_access::ttl(20, 50ms);
+	auto deadline = p._property_actual.boost.deadline();
+	p.speed += 5;
+	++p.speed;
+	int old = p.speed++;
+	assert(old == 26 && p.speed == 27);
+	assert(p._property_actual.boost.deadline() == deadline);
+	std::this_thread::sleep_for(80ms);
+	assert(p.speed == 10);
+
+	// An expired value is modified starting from the default, with no deadline.
+	p.speed += 1;
+	assert(p.speed == 11);
+	assert(p._property_actual.boost.deadline() == property_access::coarse_clock::time_point::max());
+
+	// Plain assignment stores a value with no deadline.
+	p.cooldown = true;
+	assert(p.cooldown && p._property_actual.cooling_down.deadline() == property_access::coarse_clock::time_point::max());
+	return 0;
+}
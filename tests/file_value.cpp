@@ -0,0 +1,78 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/file_value.cpp -o file_value_test && ./file_value_test
+
+#include <property_access/file_value.h>
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+
+static void write_file(const std::string &path, const char *text)    {std::ofstream(path, std::ios::trunc) << text;}
+static std::string read_file(const std::string &path)                {std::ostringstream s; s << std::ifstream(path).rdbuf(); return s.str();}
+
+
+struct Tunables
+{
+	struct Files {property_access::file_value<int> _limit; property_access::file_value<double> _ratio;};
+
+	PropertyAccessors(Files,
+		FileValue(int,    limit, _limit),
+		FileValue(double, ratio, _ratio)
+	);
+
+	Tunables(const char *limit, const char *ratio)
+		: _property_actual{property_access::file_value<int>(limit, {}), property_access::file_value<double>(ratio, {})} {}
+	~Tunables() {_property_actual.~Files();}
+};
+
+
+int main()
+{
+	std::string dir = "/tmp/property_access_file_value_test." + std::to_string(::getpid());
+	std::string limit = dir + ".limit", ratio = dir + ".ratio";
+	write_file(limit, "  42\n");
+	write_file(ratio, "0.5\n");
+
+	{
+		property_access::file_value<int> value(limit.c_str(), {});
+		assert(value.is_open() && value.get() == 42);
+
+		// Another writer leaves longer text than was last read; setting truncates to what was written.
+		write_file(limit, "123456789\n");
+		assert(value.set(1234) && read_file(limit) == "1234\n");
+		assert(value.set(7) && read_file(limit) == "7\n");
+		assert(value.get() == 7);
+
+		// A file which can't be parsed keeps the last good value, and is read again once it changes.
+		write_file(limit, "garbage\n");
+		assert(value.get() == 7 && value.get() == 7);
+		write_file(limit, "99\n");
+		assert(value.get() == 99);
+	}
+
+	{
+		// The default polling interval trusts the cached value until it expires or is refreshed.
+		property_access::file_value<int> value(limit.c_str());
+		assert(value.get() == 99);
+		write_file(limit, "5\n");
+		assert(value.get() == 99);
+		value.refresh();
+		assert(value.get() == 5);
+	}
+
+	{
+		Tunables t(limit.c_str(), ratio.c_str());
+		assert(t.limit == 5 && t.ratio == 0.5);
+		t.ratio = 0.25;
+		assert(read_file(ratio) == "0.25\n" && t.ratio == 0.25);
+	}
+
+	assert(!property_access::file_value<int>((dir + ".missing").c_str()).is_open());
+
+	std::remove(limit.c_str());
+	std::remove(ratio.c_str());
+	return 0;
+}
@@ -0,0 +1,82 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/hash.cpp -o hash_test && ./hash_test
+
+#include <property_access/hash.h>
+
+#include <cassert>
+#include <string>
+#include <unordered_set>
+
+
+struct Key
+{
+	struct State {int x, y; double w; std::string name;};
+
+	PropertyAccessors(State,
+		GetSet (int,         x,    x, int v,    x = v),
+		GetSet (int,         y,    y, int v,    y = v),
+		GetSet (double,      w,    w, double v, w = v),
+		GetOnly(std::string, name, name),
+		GetOnly(long,        area, long(x) * y)
+	);
+
+	Key(int x, int y, double w, const char *name) : _property_actual{x, y, w, name} {}
+	Key(const Key &other) : _property_actual(other._property_actual) {}
+	~Key() {_property_actual.~State();}
+
+	bool operator==(const Key &o) const    {return x == o.x && y == o.y && w == o.w && _property_actual.name == o._property_actual.name;}
+};
+
+EDB_PropertyHash(Key)
+
+
+// A block whose values are held elsewhere.
+struct Size
+{
+	struct State {int *width, *height;};
+
+	PropertyAccessors(State,
+		Proxy(int, width,  *width),
+		Proxy(int, height, *height)
+	);
+};
+
+struct Window
+{
+	struct State {Size *size; int id;};
+
+	PropertyAccessors(State,
+		Proxy  (Size, size, *size),
+		GetOnly(int,  id,   id)
+	);
+};
+
+
+int main()
+{
+	// Equal values hash equally, including both zeroes.
+	Key a(1, 2, 0.0, "a"), b(1, 2, -0.0, "a"), c(2, 1, 0.0, "a");
+	assert(property_access::hash(a) == property_access::hash(b));
+	assert(property_access::hash(a) != property_access::hash(c));
+	assert((property_access::hash_of<&Key::x, &Key::y>(a) != property_access::hash_of<&Key::y, &Key::x>(a)));
+	assert((property_access::hash_of<&Key::x, &Key::y>(a) == property_access::hash_of<&Key::x, &Key::y>(b)));
+
+	std::unordered_set<Key> set = {a, b, c};
+	assert(set.size() == 2);
+
+	// Long names go through the bulk buffer and std::hash alike.
+	Key d(1, 2, 0.0, "a long name which spans several stripes of the hasher"), e = d;
+	assert(property_access::hash(d) == property_access::hash(e));
+
+	// Nested blocks are hashed by their values, not by the pointers they hold.
+	int w1 = 640, h1 = 480, w2 = 640, h2 = 480;
+	Size   s1 = {{&w1, &h1}}, s2 = {{&w2, &h2}};
+	Window x  = {{&s1, 7}},   y  = {{&s2, 7}};
+	assert(property_access::hash(x) == property_access::hash(y));
+	h2 = 400;
+	assert(property_access::hash(x) != property_access::hash(y));
+
+	// Hashing a property accessor hashes its value.
+	assert(std::hash<decltype(a.x)>()(a.x) == std::hash<int>()(1));
+
+	return 0;
+}
@@ -0,0 +1,94 @@
+// Build and run: c++ -std=c++17 -O2 -Iinclude tests/hash_benchmark.cpp -o hash_benchmark && ./hash_benchmark
+
+#include <property_access/hash.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+// A cache key of integer fields, and one computed value.
+struct Key
+{
+	struct State {std::int64_t account; std::int32_t region, shard; std::uint64_t version; std::int32_t x, y, z, w;};
+
+	PropertyAccessors(State,
+		GetOnly(std::int64_t,  account, account),
+		GetOnly(std::int32_t,  region,  region),
+		GetOnly(std::int32_t,  shard,   shard),
+		GetOnly(std::uint64_t, version, version),
+		GetOnly(std::int32_t,  x,       x),
+		GetOnly(std::int32_t,  y,       y),
+		GetOnly(std::int32_t,  z,       z),
+		GetOnly(std::int32_t,  w,       w),
+		GetOnly(double,        ratio,   double(x) / (y | 1))
+	);
+
+	Key() : _property_actual() {}
+};
+
+
+// The usual per-field alternative.
+template<typename T>
+static void hash_combine(std::size_t &seed, const T &value)
+{
+	seed ^= std::hash<T>()(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+}
+
+static std::size_t combined_hash(const Key &k)
+{
+	std::size_t seed = 0;
+	hash_combine(seed, k.account._property_get());
+	hash_combine(seed, k.region._property_get());
+	hash_combine(seed, k.shard._property_get());
+	hash_combine(seed, k.version._property_get());
+	hash_combine(seed, k.x._property_get());
+	hash_combine(seed, k.y._property_get());
+	hash_combine(seed, k.z._property_get());
+	hash_combine(seed, k.w._property_get());
+	hash_combine(seed, k.ratio._property_get());
+	return seed;
+}
+
+
+// Keeps the hashes from being optimized away.
+static volatile std::size_t hash_sink;
+
+// Best time of several runs over all keys, in nanoseconds per key.
+template<typename F>
+static double best_ns(const std::vector<Key> &keys, F hash)
+{
+	double best = 1e300;
+	std::size_t sink = 0;
+	for (int i = 0; i < 5; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (const Key &k : keys) sink += hash(k);
+		best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / double(keys.size()));
+	}
+	hash_sink = sink;
+	return best;
+}
+
+
+int main()
+{
+	const std::size_t n = 1000000;
+	std::mt19937_64 rng(3);
+
+	std::vector<Key> keys(n);
+	for (Key &k : keys)
+		k._property_actual = Key::State{std::int64_t(rng()), std::int32_t(rng() % 64), std::int32_t(rng() % 16), rng(),
+			std::int32_t(rng()), std::int32_t(rng()), std::int32_t(rng()), std::int32_t(rng())};
+
+	std::printf("%zu keys of %zu bytes\n", n, sizeof(Key));
+	std::printf("property_access::hash          %6.2f ns/key\n", best_ns(keys, [](const Key &k) {return property_access::hash(k);}));
+	std::printf("per-field hash_combine         %6.2f ns/key\n", best_ns(keys, combined_hash));
+	std::printf("hash_of<account, version>      %6.2f ns/key\n", best_ns(keys, [](const Key &k) {return property_access::hash_of<&Key::account, &Key::version>(k);}));
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/heap.cpp -o heap_test && ./heap_test
+
+#include <property_access/heap.h>
+
+#include <cassert>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+struct Timer
+{
+	struct State {property_access::heap_entry<double, Timer> slot; int id;};
+
+	PropertyAccessors(State,
+		HeapKeyed(double, deadline, slot)
+	);
+
+	Timer(property_access::intrusive_heap<double, Timer> &heap, double deadline, int id)
+		: _property_actual() {_property_actual.id = id; _property_actual.slot.join(heap, this, deadline);}
+	~Timer() {_property_actual.~State();}
+};
+
+
+int main()
+{
+	std::mt19937 rng(5);
+	std::uniform_real_distribution<double> time(0, 1000);
+
+	property_access::intrusive_heap<double, Timer> heap;
+	std::vector<std::unique_ptr<Timer>> timers;
+	for (int i = 0; i < 1000; ++i) timers.emplace_back(new Timer(heap, time(rng), i));
+	assert(heap.size() == 1000);
+
+	// Setting keys moves timers both up and down the heap.
+	for (int round = 0; round < 5000; ++round)
+	{
+		Timer &t = *timers[rng() % timers.size()];
+		if (round % 3 == 0) t.deadline += 50;
+		else                t.deadline = time(rng);
+	}
+
+	// Destroying a block removes it from the heap.
+	for (int i = 0; i < 100; ++i) timers.erase(timers.begin() + (rng() % timers.size()));
+	assert(heap.size() == 900);
+
+	// Keys of other blocks are unchanged, and pop in order.
+	double last = -1;
+	std::size_t popped = 0;
+	while (!heap.empty())
+	{
+		double key = heap.top_key();
+		Timer *t = heap.pop();
+		assert(t->deadline == key && key >= last);
+		assert(!t->_property_actual.slot.in_heap());
+		last = key;
+		++popped;
+	}
+	assert(popped == 900);
+
+	// A timer which left the heap keeps its key, and can rejoin.
+	Timer &t = *timers.front();
+	t.deadline = 3;
+	assert(t.deadline == 3 && heap.empty());
+	t._property_actual.slot.join(heap, &t, t.deadline);
+	assert(heap.size() == 1 && heap.top() == &t);
+
+	// The greatest key is on top with std::greater.
+	{
+		struct Job
+		{
+			struct State {property_access::heap_entry<int, Job, std::greater<int>> slot;};
+
+			PropertyAccessors(State,
+				HeapKeyed(int, priority, slot)
+			);
+
+			Job() : _property_actual() {}
+			~Job() {_property_actual.~State();}
+		};
+
+		property_access::intrusive_heap<int, Job, std::greater<int>> jobs;
+		Job a, b, c;
+		a._property_actual.slot.join(jobs, &a, 1);
+		b._property_actual.slot.join(jobs, &b, 2);
+		c._property_actual.slot.join(jobs, &c, 3);
+		assert(jobs.top() == &c);
+		a.priority = 4;
+		assert(jobs.top() == &a);
+		a.priority = 0;
+		assert(jobs.top() == &c && jobs.pop() == &c && jobs.pop() == &b && jobs.pop() == &a && jobs.empty());
+	}
+
+	// Destroying the heap first detaches its entries.
+	{
+		auto temporary = std::make_unique<property_access::intrusive_heap<double, Timer>>();
+		Timer u(*temporary, 1, -1);
+		temporary.reset();
+		assert(!u._property_actual.slot.in_heap());
+	}
+
+	return 0;
+}
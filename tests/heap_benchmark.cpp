@@ -0,0 +1,119 @@
+// Build and run: c++ -std=c++17 -O2 -Iinclude tests/heap_benchmark.cpp -o heap_benchmark && ./heap_benchmark
+
+#include <property_access/heap.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+
+struct Timer
+{
+	struct State {property_access::heap_entry<double, Timer> slot;};
+
+	PropertyAccessors(State,
+		HeapKeyed(double, deadline, slot)
+	);
+
+	Timer(property_access::intrusive_heap<double, Timer> &heap, double deadline)
+		: _property_actual() {_property_actual.slot.join(heap, this, deadline);}
+	~Timer() {_property_actual.~State();}
+};
+
+
+/*
+	A scheduler's workload: timers are rescheduled at random, and every few reschedules
+		the earliest one fires and is scheduled again.  Returns the sum of the fired deadlines.
+*/
+static const std::size_t timer_count = 100000, operations = 2000000, fire_every = 4;
+
+static double run_intrusive()
+{
+	std::mt19937_64 rng(7);
+	std::uniform_real_distribution<double> delay(0, 1000);
+
+	property_access::intrusive_heap<double, Timer> heap;
+	std::vector<std::unique_ptr<Timer>> timers;
+	for (std::size_t i = 0; i < timer_count; ++i) timers.emplace_back(new Timer(heap, delay(rng)));
+
+	double now = 0, fired = 0;
+	for (std::size_t op = 0; op < operations; ++op)
+	{
+		Timer &t = *timers[rng() % timer_count];
+		t.deadline = now + delay(rng);
+		if (op % fire_every == 0)
+		{
+			now = heap.top_key();
+			fired += now;
+			Timer *first = heap.pop();
+			first->_property_actual.slot.join(heap, first, now + delay(rng));
+		}
+	}
+	return fired;
+}
+
+// The same workload with std::priority_queue, skipping stale entries when popping.
+static double run_lazy()
+{
+	std::mt19937_64 rng(7);
+	std::uniform_real_distribution<double> delay(0, 1000);
+
+	using entry = std::tuple<double, std::size_t, unsigned>;    // deadline, timer, version
+	std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+	std::vector<unsigned> version(timer_count, 0);
+	for (std::size_t i = 0; i < timer_count; ++i) queue.emplace(delay(rng), i, 0);
+
+	double now = 0, fired = 0;
+	for (std::size_t op = 0; op < operations; ++op)
+	{
+		std::size_t t = rng() % timer_count;
+		queue.emplace(now + delay(rng), t, ++version[t]);
+		if (op % fire_every == 0)
+		{
+			while (std::get<2>(queue.top()) != version[std::get<1>(queue.top())]) queue.pop();
+			std::size_t first = std::get<1>(queue.top());
+			now = std::get<0>(queue.top());
+			queue.pop();
+			fired += now;
+			queue.emplace(now + delay(rng), first, ++version[first]);
+		}
+	}
+	return fired;
+}
+
+
+// Best time of several runs, in milliseconds.
+template<typename F>
+static double best_ms(F run, double &result)
+{
+	double best = 1e300;
+	for (int i = 0; i < 3; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		result = run();
+		best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	return best;
+}
+
+
+int main()
+{
+	double intrusive_fired, lazy_fired;
+	double intrusive = best_ms(run_intrusive, intrusive_fired);
+	double lazy      = best_ms(run_lazy, lazy_fired);
+	assert(intrusive_fired == lazy_fired);
+
+	std::printf("%zu timers, %zu reschedules, firing every %zu\n", timer_count, operations, fire_every);
+	std::printf("intrusive_heap                        %8.2f ms\n", intrusive);
+	std::printf("std::priority_queue, lazy deletion    %8.2f ms\n", lazy);
+
+	return 0;
+}
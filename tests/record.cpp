@@ -0,0 +1,104 @@
+// Build and run: c++ -std=c++17 -pthread -Iinclude tests/record.cpp -o record_test && ./record_test
+
+#include <property_access/record.h>
+
+#include <cassert>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+
+struct Job
+{
+	struct State {std::uint32_t id; int progress; int total;};
+
+	PropertyAccessors(State,
+		Recorded(int, progress, progress, id),
+		Recorded(int, total,    total,    id)
+	);
+
+	explicit Job(std::uint32_t id) : _property_actual{id, 0, 0} {}
+};
+
+// A reflectable block declared without the macro, whose property has no name.
+struct Raw
+{
+	struct Actual {int v;};
+	struct GetSet : Actual {int get() const {return v;}  void set(int x) {v = x;}};
+
+	union {Actual _property_actual; property_access::property<GetSet> value;};
+
+	auto _property_fields() const    {return std::make_tuple(std::addressof(value));}
+	auto _property_fields()          {return std::make_tuple(std::addressof(value));}
+};
+
+
+int main()
+{
+	const char *path = "record_test.log";
+
+	// Writes from several threads replay in each thread's order.
+	assert(property_access::start_recording(path));
+	std::vector<std::thread> threads;
+	for (std::uint32_t t = 0; t < 4; ++t) threads.emplace_back([t]
+	{
+		Job job(t + 1);
+		for (int i = 1; i <= 1000; ++i) job.progress = i;
+		job.total = int(t) * 10;
+	});
+	for (auto &t : threads) t.join();
+	property_access::stop_recording();
+
+	{
+		property_access::replay_log log(path);
+		assert(log.size() == 4 * 1001);
+		for (std::uint32_t t = 0; t < 4; ++t)
+		{
+			Job fresh(t + 1);
+			assert(log.apply(fresh, t + 1) == 1001);
+			assert(fresh.progress == 1000);
+			assert(fresh.total == int(t) * 10);
+		}
+
+		// Entries of one thread stay in sequence after merging.
+		std::uint64_t last[4] = {};
+		bool seen[4] = {};
+		for (auto &e : log)
+		{
+			assert(!seen[e.header.block - 1] || e.header.seq > last[e.header.block - 1]);
+			seen[e.header.block - 1] = true;
+			last[e.header.block - 1] = e.header.seq;
+		}
+	}
+
+	// Entries left in a buffer when a log stops don't leak into the next log.
+	assert(property_access::start_recording(path));
+	Job job(7);
+	job.progress = 1;
+	{
+		// Stop from another thread, so this thread's buffer isn't flushed.
+		std::thread([] {property_access::stop_recording();}).join();
+	}
+	assert(property_access::start_recording(path));
+	job.progress = 2;
+	property_access::stop_recording();
+	{
+		property_access::replay_log log(path);
+		assert(log.size() == 1);
+		Job fresh(7);
+		assert(log.apply(fresh, 7) == 1);
+		assert(fresh.progress == 2);
+
+		// Unnamed properties are skipped.
+		Raw raw = {{5}};
+		assert(log.apply(raw, 7) == 0 && raw.value == 5);
+	}
+
+	// Nothing is recorded while recording is off.
+	job.progress = 3;
+	property_access::flush_recording();
+	assert(property_access::replay_log(path).size() == 1);
+
+	std::remove(path);
+	return 0;
+}
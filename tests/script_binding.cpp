@@ -0,0 +1,108 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/script_binding.cpp -o script_binding_test && ./script_binding_test
+
+#include <property_access/script_binding.h>
+
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+
+
+struct Entity
+{
+	struct State {int hp; unsigned char flags; double speed; std::int64_t score; float scale; unsigned mask;};
+
+	PropertyAccessors(State,
+		GetSet (int,           health,   hp,    int v,           hp = v),
+		GetSet (unsigned char, bits,     flags, unsigned char v, flags = v),
+		GetSet (double,        velocity, speed, double v,        speed = v),
+		GetSet (std::int64_t,  points,   score, std::int64_t v,  score = v),
+		GetSet (float,         size,     scale, float v,         scale = v),
+		GetSet (unsigned,      filter,   mask,  unsigned v,      mask = v),
+		GetOnly(bool,          alive,    hp > 0)
+	);
+};
+
+// A reflectable block declared without the macro, whose property has no name.
+struct Raw
+{
+	struct Actual {int v;};
+	struct GetSet : Actual {int get() const {return v;}  void set(int x) {v = x;}};
+
+	union {Actual _property_actual; property_access::property<GetSet> value;};
+
+	auto _property_fields() const    {return std::make_tuple(std::addressof(value));}
+	auto _property_fields()          {return std::make_tuple(std::addressof(value));}
+};
+
+
+using namespace property_access;
+
+int main()
+{
+	Entity e = {{10, 1, 2.0, 0, 1.0f, 1}};
+	const binding_table &table = binding_table::of<Entity>();
+	auto *health = table.find(intern("health")), *bits = table.find(intern("bits")), *velocity = table.find(intern("velocity"));
+	auto *points = table.find(intern("points")), *size = table.find(intern("size")), *filter = table.find(intern("filter"));
+	auto *alive  = table.find(intern("alive"));
+	assert(health && bits && velocity && points && size && filter && alive);
+
+	// Supported operations.
+	assert(health->apply(&e, script_op::subtract, script_value(5)) && e.health == 5);
+	assert(health->apply(&e, script_op::shift_left, script_value(2)) && e.health == 20);
+	assert(velocity->apply(&e, script_op::divide, script_value(0)) && std::isinf(double(e.velocity)));
+	assert(alive->get(&e).kind == script_value::boolean && alive->get(&e).b);
+	assert(!alive->apply(&e, script_op::assign, script_value(false)));
+
+	// Division by zero, MIN / -1 and bad shift counts are rejected.
+	assert(!health->apply(&e, script_op::divide, script_value(0)) && e.health == 20);
+	assert(!health->apply(&e, script_op::modulo, script_value(0)));
+	assert(!health->apply(&e, script_op::shift_left, script_value(32)));
+	assert(!health->apply(&e, script_op::shift_right, script_value(-1)));
+	assert(health->apply(&e, script_op::assign, script_value(INT_MIN)));
+	assert(!health->apply(&e, script_op::divide, script_value(-1)) && !health->apply(&e, script_op::modulo, script_value(-1)));
+	assert(!health->apply(&e, script_op::shift_left, script_value(1)));  // negative value.
+
+	// Signed overflow is rejected, for each operation and in both directions.
+	assert(!health->apply(&e, script_op::subtract, script_value(1)) && e.health == INT_MIN);
+	assert(!health->apply(&e, script_op::add, script_value(-1)));
+	assert(!health->apply(&e, script_op::multiply, script_value(-1)));
+	assert(!health->apply(&e, script_op::multiply, script_value(2)));
+	assert(health->apply(&e, script_op::assign, script_value(INT_MAX)));
+	assert(!health->apply(&e, script_op::add, script_value(1)) && e.health == INT_MAX);
+	assert(!health->apply(&e, script_op::subtract, script_value(-1)));
+	assert(!health->apply(&e, script_op::multiply, script_value(2)) && !health->apply(&e, script_op::multiply, script_value(-2)));
+	assert(!health->apply(&e, script_op::shift_left, script_value(1)));
+	assert(health->apply(&e, script_op::assign, script_value(1 << 29)) && health->apply(&e, script_op::shift_left, script_value(1)) && e.health == 1 << 30);
+	assert(!health->apply(&e, script_op::shift_left, script_value(1)));
+	assert(health->apply(&e, script_op::multiply, script_value(-2)) && e.health == INT_MIN);
+
+	assert(points->apply(&e, script_op::assign, script_value(INT64_MAX)));
+	assert(!points->apply(&e, script_op::add, script_value(1)) && !points->apply(&e, script_op::multiply, script_value(3)));
+	assert(points->apply(&e, script_op::subtract, script_value(INT64_MAX)) && e.points == 0);
+
+	// Unsigned arithmetic wraps, as defined.
+	assert(filter->apply(&e, script_op::subtract, script_value(2)) && e.filter == UINT_MAX);
+
+	// Unboxing rejects values the property can't represent.
+	assert(!health->apply(&e, script_op::assign, script_value(std::nan(""))));
+	assert(!health->apply(&e, script_op::assign, script_value(1e20)));
+	assert(!health->apply(&e, script_op::assign, script_value(std::int64_t(1) << 40)));
+	assert(!health->apply(&e, script_op::assign, script_value(2147483648.0)));
+	assert(health->apply(&e, script_op::assign, script_value(2147483647.0)) && e.health == INT_MAX);
+	assert(!bits->apply(&e, script_op::assign, script_value(300)) && !bits->apply(&e, script_op::assign, script_value(-1)));
+	assert(!size->apply(&e, script_op::assign, script_value(1e300)) && !size->apply(&e, script_op::add, script_value(-1e300)));
+	assert(size->apply(&e, script_op::assign, script_value(HUGE_VAL)) && std::isinf(float(e.size)));
+	assert(size->apply(&e, script_op::assign, script_value(std::nan(""))) && std::isnan(float(e.size)));
+
+	// The inline cache is keyed by table and name.
+	binding_cache cache;
+	assert(cache.find(table, intern("health")) == health && cache.find(table, intern("bits")) == bits);
+	assert(cache.find(table, intern("missing")) == nullptr);
+
+	// Properties without names are not bound.
+	auto &raw = binding_table::of<Raw>();
+	assert(raw.begin() == raw.end());
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/skip_unchanged.cpp -o skip_unchanged_test && ./skip_unchanged_test
+
+#include <property_accessor.h>
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+
+// A value that counts how often it's assigned.
+struct Tracked
+{
+	int value;
+	static inline int writes = 0;
+
+	Tracked(int v = 0) : value(v) {}
+	Tracked(const Tracked &o) : value(o.value) {}
+	Tracked &operator=(const Tracked &o) {value = o.value; ++writes; return *this;}
+	Tracked &operator+=(int y) {value += y; return *this;}
+	bool operator==(const Tracked &o) const {return value == o.value;}
+};
+
+
+// Skipping is enabled for every property through the actual struct.
+struct Counted
+{
+	struct State
+	{
+		static constexpr bool _property_option_skip_unchanged = true;
+		int n; double d; Tracked t; int sets;
+	};
+
+	PropertyAccessors(State,
+		Custom(count, int    get() const {return n;}  void set(int v)    {n = v; ++sets;}),
+		Custom(level, double get() const {return d;}  void set(double v) {d = v; ++sets;}),
+		Custom(tally, Tracked get() const {return t;} template<typename F> void modify(F f) {f(t);})
+	);
+
+	Counted() : _property_actual() {}
+	~Counted() {_property_actual.~State();}
+};
+
+// A setter that may run elsewhere, as with Actor properties, is never skipped.
+struct Deferred
+{
+	struct State {int n; int sets;};
+
+	PropertyAccessors(State,
+		Custom(count,
+			static constexpr bool _property_option_skip_unchanged = true;
+			static constexpr bool _property_option_deferred_modify = true;
+			int get() const {return n;}  void set(int v) {n = v; ++sets;}
+			template<typename F> void modify(F f) {f(n);})
+	);
+};
+
+
+int main()
+{
+	Counted c;
+
+	// Plain assignment.
+	c.count = 3;
+	assert(c.count == 3 && c._property_actual.sets == 1);
+	c.count = 3;
+	assert(c._property_actual.sets == 1);
+
+	// Compound assignment through get and set.
+	c.count += 0;
+	c.count *= 1;
+	assert(c._property_actual.sets == 1);
+	c.count += 2;
+	assert(c.count == 5 && c._property_actual.sets == 2);
+
+	// Compound assignment through modify(f) only stores a changed result.
+	int writes = Tracked::writes;
+	c.tally += 0;
+	assert(Tracked::writes == writes);
+	c.tally += 4;
+	assert(Tracked::writes == writes + 1 && c._property_actual.t.value == 4);
+
+	// Floating point values are compared bitwise.
+	int sets = c._property_actual.sets;
+	c.level = 0.0;
+	assert(c._property_actual.sets == sets);
+	c.level = 1.0;
+	c.level = 0.0;
+	sets += 1;
+	assert(c._property_actual.sets == sets + 1);
+	c.level = -0.0;
+	assert(c._property_actual.sets == sets + 2 && std::signbit(c._property_actual.d));
+	c.level *= -1.0;
+	assert(c._property_actual.sets == sets + 3 && !std::signbit(c._property_actual.d));
+
+	// A NaN equals itself bit for bit, so assigning it again is skipped.
+	double nan = std::numeric_limits<double>::quiet_NaN();
+	c.level = nan;
+	assert(c._property_actual.sets == sets + 4 && std::isnan(c._property_actual.d));
+	c.level = nan;
+	c.level += 1.0;
+	assert(c._property_actual.sets == sets + 4);
+
+	// Deferred getter/setters always set, so set() never reads the value off its owner.
+	Deferred d{};
+	d.count = 0;
+	d.count = 0;
+	assert(d._property_actual.sets == 2);
+	d.count += 1;
+	assert(d.count == 1 && d._property_actual.sets == 2);
+
+	return 0;
+}
@@ -0,0 +1,65 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/snapshot.cpp -o snapshot_test && ./snapshot_test
+
+#include <property_access/snapshot.h>
+
+#include <cassert>
+#include <csignal>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+
+struct Account
+{
+	struct State {long balance; int id;};
+
+	PropertyAccessors(State,
+		GetSet (long, balance, balance, long v, balance = v),
+		GetOnly(int,  id,      id)
+	);
+};
+
+
+int main()
+{
+	std::string path = "/tmp/property_access_snapshot_test." + std::to_string(::getpid());
+	std::remove(path.c_str());
+
+	Account accounts[3] = {{{10, 1}}, {{20, 2}}, {{30, 3}}};
+	auto snap = property_access::fork_snapshot(path.c_str(), [&](property_access::snapshot_writer &out)
+	{
+		out.write_blocks(accounts, 3);
+	});
+	accounts[0].balance = 99;    // not seen by the child
+	assert(snap.wait() && snap.done());
+
+	Account restored[3] = {};
+	property_access::snapshot_reader in(path.c_str());
+	assert(in.read_blocks(restored, 3));
+	assert(restored[0].balance == 10 && restored[1].balance == 20 && restored[2].balance == 30);
+
+	// A serializer that throws fails the snapshot and leaves the previous file in place.
+	auto failed = property_access::fork_snapshot(path.c_str(), [&](property_access::snapshot_writer &out)
+	{
+		out.write_blocks(accounts, 3);
+		throw std::runtime_error("no");
+	});
+	assert(!failed.wait());
+	assert(::access((path + ".tmp").c_str(), F_OK) != 0);
+	property_access::snapshot_reader again(path.c_str());
+	assert(again.read_blocks(restored, 3) && restored[0].balance == 10);
+
+	// With SIGCHLD ignored the child is reaped by the kernel, so it finishes without succeeding.
+	std::signal(SIGCHLD, SIG_IGN);
+	auto reaped = property_access::fork_snapshot(path.c_str(), [&](property_access::snapshot_writer &out)
+	{
+		out.write_blocks(accounts, 3);
+	});
+	while (!reaped.done()) ::usleep(1000);
+	assert(!reaped.succeeded());
+	std::signal(SIGCHLD, SIG_DFL);
+
+	std::remove(path.c_str());
+	return 0;
+}
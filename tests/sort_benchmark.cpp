@@ -0,0 +1,81 @@
+// Build and run: c++ -std=c++17 -O2 -Iinclude tests/sort_benchmark.cpp -o sort_benchmark && ./sort_benchmark
+
+#include <property_access/sort.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+
+// A large block sorted by a computed property and by a stored one.
+struct Unit
+{
+	struct State {float x, y; int id; char payload[116];};
+
+	PropertyAccessors(State,
+		GetOnly(float, distance, std::sqrt(x * x + y * y)),
+		GetOnly(int,   id,       id)
+	);
+
+	Unit() : _property_actual() {}
+};
+
+static float distance(const Unit::State &s)    {return std::sqrt(s.x * s.x + s.y * s.y);}
+
+
+// Best time of several runs, in milliseconds.  reset() restores the input before each run.
+template<typename Reset, typename Run>
+static double best_ms(Reset reset, Run run)
+{
+	double best = 1e300;
+	for (int i = 0; i < 5; ++i)
+	{
+		reset();
+		auto start = std::chrono::steady_clock::now();
+		run();
+		best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	return best;
+}
+
+
+int main()
+{
+	const std::size_t n = 200000;
+	std::mt19937 rng(11);
+	std::uniform_real_distribution<float> coordinate(-1000, 1000);
+
+	std::vector<Unit::State> input(n);
+	for (std::size_t i = 0; i < n; ++i) input[i] = Unit::State{coordinate(rng), coordinate(rng), int(rng() % 1000000), {}};
+
+	std::vector<Unit>        units(n);
+	std::vector<Unit::State> states(n);
+	auto reset_units  = [&] {for (std::size_t i = 0; i < n; ++i) units[i]._property_actual = input[i];};
+	auto reset_states = [&] {states = input;};
+
+	std::printf("%zu blocks of %zu bytes\n", n, sizeof(Unit));
+
+	// The computed key is read once per block, against once per comparison.
+	double by_key = best_ms(reset_units, [&] {property_access::sort_by(units.data(), n, &Unit::distance);});
+	for (std::size_t i = 1; i < n; ++i) assert(units[i - 1].distance <= units[i].distance);
+	double by_std = best_ms(reset_states, [&] {std::sort(states.begin(), states.end(), [](const auto &a, const auto &b) {return distance(a) < distance(b);});});
+	double by_stable = best_ms(reset_states, [&] {std::stable_sort(states.begin(), states.end(), [](const auto &a, const auto &b) {return distance(a) < distance(b);});});
+	std::printf("computed float key:  sort_by %8.2f ms   std::sort %8.2f ms   std::stable_sort %8.2f ms\n", by_key, by_std, by_stable);
+
+	by_key = best_ms(reset_units, [&] {property_access::sort_by(units.data(), n, &Unit::id);});
+	for (std::size_t i = 1; i < n; ++i) assert(units[i - 1].id <= units[i].id);
+	by_std = best_ms(reset_states, [&] {std::sort(states.begin(), states.end(), [](const auto &a, const auto &b) {return a.id < b.id;});});
+	by_stable = best_ms(reset_states, [&] {std::stable_sort(states.begin(), states.end(), [](const auto &a, const auto &b) {return a.id < b.id;});});
+	std::printf("stored int key:      sort_by %8.2f ms   std::sort %8.2f ms   std::stable_sort %8.2f ms\n", by_key, by_std, by_stable);
+
+	// A comparator takes the comparison sort path.
+	by_key = best_ms(reset_units, [&] {property_access::sort_by(units.data(), n, &Unit::distance, std::greater<>());});
+	by_stable = best_ms(reset_states, [&] {std::stable_sort(states.begin(), states.end(), [](const auto &a, const auto &b) {return distance(a) > distance(b);});});
+	std::printf("with a comparator:   sort_by %8.2f ms   std::stable_sort %8.2f ms\n", by_key, by_stable);
+
+	return 0;
+}
@@ -0,0 +1,55 @@
+// Build and run: c++ -std=c++17 -Iinclude tests/statistics.cpp -o statistics_test && ./statistics_test
+
+#include <property_access/statistics.h>
+
+#include <cmath>
+#include <cassert>
+
+int main()
+{
+	const double error = 0.02, min_value = 1e-6, gamma = (1 + error) / (1 - error);
+	property_access::quantile_sketch<> sketch(error, min_value);
+
+	auto estimate = [&](double value)
+	{
+		sketch.reset();
+		sketch.record(value);
+		return sketch.quantile(0.5);
+	};
+
+	// Values below min_value count as zero; min_value itself is estimated within the error.
+	assert(estimate(0) == 0 && estimate(min_value / 2) == 0 && estimate(-1) == 0);
+	assert(std::abs(estimate(min_value) - min_value) <= min_value * error * 1.000001);
+
+	// Values at, just below and just above each bucket boundary are estimated within the error.
+	for (int k = 0; k < 1000; ++k)
+	{
+		double boundary = min_value * std::pow(gamma, k);
+		for (double value : {boundary * (1 - 1e-9), boundary, boundary * (1 + 1e-9)})
+		{
+			if (value < min_value) continue;
+			assert(std::abs(estimate(value) - value) <= value * error * 1.000001);
+		}
+	}
+
+	// Bucket boundaries are exclusive below and inclusive above: values just above a boundary
+	//    and the boundary itself fall in adjacent buckets, whose estimates differ by a factor of gamma.
+	double boundary = min_value * std::pow(gamma, 10);
+	double below = estimate(boundary * (1 - 1e-9)), above = estimate(boundary * (1 + 1e-9));
+	assert(std::abs(above / below - gamma) < 1e-6);
+
+	// Quantiles and merging.
+	property_access::quantile_sketch<> a, b;
+	for (int i = 1; i <= 1000; ++i) a.record(i);
+	for (int i = 1001; i <= 2000; ++i) b.record(i);
+	a.merge(b);
+	assert(a.count() == 2000);
+	assert(std::abs(a.quantile(0.5) - 1000) <= 1000 * error * 1.01);
+	assert(std::abs(a.quantile(0.99) - 1980) <= 1980 * error * 1.01);
+
+	// High-water marks only increase.
+	property_access::high_water<int> peak;
+	peak.record(3); peak.record(10); peak.record(4);
+	assert(peak.get() == 10);
+	return 0;
+}
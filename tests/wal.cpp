@@ -0,0 +1,132 @@
+// Build and run: c++ -std=c++17 -pthread -Iinclude tests/wal.cpp -o wal_test && ./wal_test
+
+#include <property_access/wal.h>
+
+#include <cassert>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+
+
+struct Account {long balance; int flags;};
+
+struct Ledger
+{
+	struct Ref {Account *account; property_access::write_ahead_log *log;};
+
+	PropertyAccessors(Ref,
+		Logged(long, balance, account->balance, *log),
+		Logged(int,  flags,   account->flags,   *log)
+	);
+};
+
+
+static const char *data_path = "wal_test.dat", *log_path = "wal_test.wal";
+static const std::size_t count = 1000;
+
+// Run f in a child process which then dies without closing anything, as in a crash.
+template<typename F>
+void crash_after(F f)
+{
+	pid_t pid = ::fork();
+	if (pid == 0)
+	{
+		property_access::write_ahead_log store(data_path, log_path, count * sizeof(Account));
+		f(store, static_cast<Account*>(store.data()));
+		::_exit(0);
+	}
+	int status;
+	::waitpid(pid, &status, 0);
+	assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+static long data_file_balance(std::size_t i)
+{
+	Account a;
+	FILE *f = std::fopen(data_path, "rb");
+	std::fseek(f, long(i * sizeof(Account)), SEEK_SET);
+	assert(std::fread(&a, sizeof(a), 1, f) == 1);
+	std::fclose(f);
+	return a.balance;
+}
+
+
+int main()
+{
+	std::remove(data_path);
+	std::remove(log_path);
+
+	// Committed writes from several threads survive a crash; uncommitted ones don't reach the data file.
+	crash_after([](property_access::write_ahead_log &store, Account *accounts)
+	{
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < 4; ++t) threads.emplace_back([&, t]
+		{
+			for (std::size_t i = t; i < count; i += 4)
+			{
+				Ledger l = {{&accounts[i], &store}};
+				l.balance = long(i) * 10;
+				l.flags   = 1;
+				store.commit();
+			}
+		});
+		for (auto &t : threads) t.join();
+
+		Ledger l = {{&accounts[0], &store}};
+		l.balance = 777;  // never committed.
+		::msync(store.data(), store.size(), MS_SYNC);
+	});
+	assert(data_file_balance(0) == 0 && data_file_balance(1) == 0);  // Only the log has the committed writes.
+
+	{
+		property_access::write_ahead_log store(data_path, log_path, count * sizeof(Account));
+		auto accounts = static_cast<Account*>(store.data());
+		for (std::size_t i = 0; i < count; ++i) assert(accounts[i].balance == long(i) * 10 && accounts[i].flags == 1);
+	}
+	assert(data_file_balance(1) == 10);  // Recovery checkpointed the log into the data file.
+
+	// A checkpoint writes committed records only; later uncommitted writes are lost in a crash.
+	crash_after([](property_access::write_ahead_log &store, Account *accounts)
+	{
+		Ledger a = {{&accounts[5], &store}}, b = {{&accounts[6], &store}};
+		a.balance = 5000;
+		store.commit();
+		b.balance = 6000;  // pending during the checkpoint.
+		assert(store.checkpoint());
+		a.balance = 5001;
+	});
+	assert(data_file_balance(5) == 5000 && data_file_balance(6) == 60);
+	{
+		property_access::write_ahead_log store(data_path, log_path, count * sizeof(Account));
+		auto accounts = static_cast<Account*>(store.data());
+		assert(accounts[5].balance == 5000 && accounts[6].balance == 60);
+
+		// Records pending at a checkpoint are committed to the emptied log afterwards.
+		Ledger a = {{&accounts[7], &store}};
+		a.balance = 1;
+		store.commit();
+		a.balance = 2;
+		store.commit();
+	}
+
+	// Replay stops at a torn record.  Opening the store first checkpoints and empties the log.
+	crash_after([](property_access::write_ahead_log &store, Account *accounts)
+	{
+		Ledger a = {{&accounts[8], &store}};
+		a.balance = 1;
+		store.commit();
+		a.balance = 2;
+		store.commit();
+	});
+	assert(::truncate(log_path, sizeof(property_access::write_ahead_log::record_header) + sizeof(long) + 4) == 0);
+	{
+		property_access::write_ahead_log store(data_path, log_path, count * sizeof(Account));
+		auto accounts = static_cast<Account*>(store.data());
+		assert(accounts[7].balance == 2 && accounts[8].balance == 1);
+	}
+
+	std::remove(data_path);
+	std::remove(log_path);
+	return 0;
+}